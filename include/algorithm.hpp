@@ -14,6 +14,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <frame_arena.hpp>
 #include <vector3.hpp>
 #include <vector>
 
@@ -35,7 +36,10 @@ class IntersectionCalculator
 class Bresenham
 {
   public:
+    using Points = ArenaVector<std::pair<uint32_t, uint32_t>>;
+
     auto CalculateLine(float &x0, float &y0, float &x1, float &y1) -> std::vector<std::pair<uint32_t, uint32_t>>;
+    auto CalculateLine(float &x0, float &y0, float &x1, float &y1, Points &points) -> void;
 };
 
 // https://en.wikipedia.org/wiki/Cohen%E2%80%93Sutherland_algorithm
@@ -47,6 +51,7 @@ class CohenSutherland
 
   public:
     auto CohenSutherlandLineClip(float &x0, float &y0, float &x1, float &y1) -> bool;
+    auto setBounds(uint32_t width, uint32_t height) -> void;
 
   private:
     uint32_t width_minus_1_;
@@ -0,0 +1,171 @@
+/**
+ * @file camera.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-22
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <transform.hpp>
+#include <utility>
+#include <vector3.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Pinhole intrinsics in pixels, following the OpenCV convention (x right, y down, z forward)
+ */
+struct CameraIntrinsics
+{
+    float fx;
+    float fy;
+    float cx;
+    float cy;
+    uint32_t width;
+    uint32_t height;
+};
+
+/**
+ * @brief Brown–Conrady lens distortion with three radial and two tangential coefficients
+ */
+struct BrownConradyDistortion
+{
+    float k1 = 0;
+    float k2 = 0;
+    float p1 = 0;
+    float p2 = 0;
+    float k3 = 0;
+
+    /**
+     * @brief Maps an ideal normalized image point to where the lens actually images it
+     */
+    auto distort(float x, float y) const -> std::pair<float, float>
+    {
+        float r2 = x * x + y * y;
+        float radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+        return {x * radial + 2 * p1 * x * y + p2 * (r2 + 2 * x * x),
+                y * radial + p1 * (r2 + 2 * y * y) + 2 * p2 * x * y};
+    }
+
+    /**
+     * @brief Inverts distort() by fixed point iteration, accurate for the distortion of real lenses
+     */
+    auto undistort(float x_distorted, float y_distorted, int iterations = 20) const -> std::pair<float, float>
+    {
+        float x = x_distorted;
+        float y = y_distorted;
+        for (int i = 0; i < iterations; ++i)
+        {
+            float r2 = x * x + y * y;
+            float radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+            float dx = 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+            float dy = p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+            x = (x_distorted - dx) / radial;
+            y = (y_distorted - dy) / radial;
+        }
+        return {x, y};
+    }
+
+    auto isIdentity() const -> bool
+    {
+        return k1 == 0 && k2 == 0 && p1 == 0 && p2 == 0 && k3 == 0;
+    }
+};
+
+/**
+ * @brief Calibrated pinhole camera that projects world points straight to screen space
+ *
+ * The projected x and y are pixels and z is the view depth mapped linearly to [0, 1] between the near and far plane,
+ * the same convention Rasterizer::projectBasicPerspective uses, so results can be passed to any draw call.
+ */
+class PinholeCamera
+{
+  public:
+    PinholeCamera(const CameraIntrinsics &intrinsics, const BrownConradyDistortion &distortion = {},
+                  const Transform &world_to_camera = Transform(), float near_plane = 0.1f, float far_plane = 1000.0f);
+    ~PinholeCamera() = default;
+
+    /**
+     * @brief Projects with the ideal pinhole model, distortion is left to a DistortionRemap post pass
+     */
+    auto project(const Vector3<float> &world) const -> Vector3<float>
+    {
+        return projectFromCamera(world_to_camera_.apply(world));
+    }
+
+    auto projectFromCamera(const Vector3<float> &camera) const -> Vector3<float>
+    {
+        float inv_z = 1.0f / camera.z();
+        return Vector3<float>(intrinsics_.fx * camera.x() * inv_z + intrinsics_.cx,
+                              intrinsics_.fy * camera.y() * inv_z + intrinsics_.cy,
+                              (camera.z() - near_plane_) * inv_depth_range_);
+    }
+
+    /**
+     * @brief Projects and applies lens distortion per vertex, exact at the vertices only
+     */
+    auto projectDistorted(const Vector3<float> &world) const -> Vector3<float>;
+
+    auto setExtrinsics(const Transform &world_to_camera) -> void;
+
+    auto getIntrinsics() const -> const CameraIntrinsics &;
+    auto getDistortion() const -> const BrownConradyDistortion &;
+    auto getExtrinsics() const -> const Transform &;
+    auto getNearPlane() const -> float;
+    auto getFarPlane() const -> float;
+
+  private:
+    CameraIntrinsics intrinsics_;
+    BrownConradyDistortion distortion_;
+    Transform world_to_camera_;
+    float near_plane_;
+    float far_plane_;
+    float inv_depth_range_;
+};
+
+/**
+ * @brief Precomputed lookup table that warps an ideal pinhole render into the distorted camera image
+ *
+ * Building the table inverts the distortion once per pixel, applying it is a sequential walk over the table with four
+ * taps and fixed point bilinear weights per pixel. Samples on the outer half pixel of the source clamp to its edge,
+ * pixels that map further outside become transparent black.
+ */
+class DistortionRemap
+{
+  public:
+    explicit DistortionRemap(const PinholeCamera &camera);
+    ~DistortionRemap() = default;
+
+    auto apply(const FrameBuffer &undistorted, FrameBuffer &distorted) const -> void;
+
+  private:
+    struct Entry
+    {
+        uint32_t offset; // Index of the top left source tap
+        uint8_t fx;      // Horizontal weight of the right taps in 1/256
+        uint8_t fy;      // Vertical weight of the bottom taps in 1/256
+        uint8_t valid;
+        uint8_t steps;   // kRightTap and kBottomTap when the neighbouring taps exist
+    };
+
+    static constexpr uint8_t kRightTap = 1;
+    static constexpr uint8_t kBottomTap = 2;
+
+    uint32_t width_;
+    uint32_t height_;
+    std::vector<Entry> table_;
+};
+
+} // namespace cam3d
+
+#endif // CAMERA_H
@@ -0,0 +1,128 @@
+/**
+ * @file command_buffer.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-26
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <rasterizer.hpp>
+#include <string>
+#include <type_traits>
+#include <vector3.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+enum class CommandType : uint8_t
+{
+    Line,
+    Triangle
+};
+
+/**
+ * @brief Fragment shading a recorded triangle is replayed with
+ */
+enum class FillMode : uint8_t
+{
+    Flat,  // FlatFragmentShader with the command color
+    Depth  // DepthFragmentShader
+};
+
+/**
+ * @brief A recorded draw, plain data so buffers can be sorted, replayed and written to disk as is
+ *
+ * Vertices are in screen space, already projected.
+ */
+struct DrawCommand
+{
+    CommandType type;
+    FillMode fill;
+    uint8_t opaque;
+    uint8_t padding;
+    uint32_t sequence;
+    ARGB color;
+    float vertices[3][3];
+
+    auto getVertex(size_t i) const -> Vector3<float>
+    {
+        return Vector3<float>(vertices[i][0], vertices[i][1], vertices[i][2]);
+    }
+
+    /// @brief Sort key grouping draws that replay with the same pipeline state
+    auto getStateKey() const -> uint32_t
+    {
+        return (static_cast<uint32_t>(type) << 8) | static_cast<uint32_t>(fill);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<DrawCommand>, "Draw commands must stay plain data");
+
+/**
+ * @brief Records draw calls instead of executing them, so they can be reordered and replayed across frames
+ *
+ * sort() moves opaque draws to the front, grouped by pipeline state and front to back inside each group so the
+ * depth test rejects hidden pixels early. Non opaque draws (lines, overlays) keep their submission order after them.
+ */
+class CommandBuffer
+{
+  public:
+    CommandBuffer() = default;
+    ~CommandBuffer() = default;
+
+    auto recordLine(const Vector3<float> &p_start, const Vector3<float> &p_end, const ARGB &color) -> void;
+    auto recordTriangle(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
+                        const ARGB &color, FillMode fill = FillMode::Flat, bool opaque = true) -> void;
+
+    auto sort() -> void;
+    auto execute(Rasterizer &rasterizer, FrameBuffer &fb) const -> void;
+
+    /**
+     * @brief Replays only the opaque triangles into the depth buffer
+     *
+     * Follow it with executeAfterPrepass() so each visible pixel is shaded exactly once.
+     */
+    auto executeDepthOnly(Rasterizer &rasterizer, FrameBuffer &fb) const -> void;
+
+    /**
+     * @brief Color pass after executeDepthOnly()
+     *
+     * Opaque triangles replay under DepthTest::Equal. Everything the prepass skipped replays under DepthTest::Less,
+     * since those draws have no depth of their own in the buffer and would fail an equality test. The depth test of
+     * the rasterizer is restored afterwards.
+     */
+    auto executeAfterPrepass(Rasterizer &rasterizer, FrameBuffer &fb) const -> void;
+
+    auto clear() -> void;
+
+    auto append(const CommandBuffer &other) -> void;
+
+    /**
+     * @brief Writes the commands in binary form for offline replay and profiling
+     *
+     * @return false if the file could not be written
+     */
+    auto save(const std::string &path) const -> bool;
+    auto load(const std::string &path) -> bool;
+
+    auto getCommands() const -> const std::vector<DrawCommand> &;
+    auto size() const -> size_t;
+
+  private:
+    static auto replay(const DrawCommand &command, Rasterizer &rasterizer, FrameBuffer &fb) -> void;
+
+    std::vector<DrawCommand> commands_;
+};
+
+} // namespace cam3d
+
+#endif // COMMAND_BUFFER_H
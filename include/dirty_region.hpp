@@ -0,0 +1,111 @@
+/**
+ * @file dirty_region.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <frame_buffer.hpp>
+#include <type_traits>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Incremental FNV-1a hash over the parameters of a draw call
+ *
+ * Two draws with the same signature and bounds are assumed to produce the same pixels.
+ */
+class DrawSignature
+{
+  public:
+    template <typename T> auto add(const T &value) -> DrawSignature &
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed");
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (auto byte : bytes)
+        {
+            hash_ = (hash_ ^ byte) * 0x100000001b3ull;
+        }
+        return *this;
+    }
+
+    auto getValue() const -> uint64_t
+    {
+        return hash_;
+    }
+
+  private:
+    uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+/**
+ * @brief Tracks the screen bounds of every draw between frames and reports the tiles that need to be redrawn
+ *
+ * Draws are matched by submission order. A draw whose bounds or signature changed marks both its old and new bounds
+ * dirty, so a static scene produces no dirty regions at all.
+ */
+class DirtyRegionTracker
+{
+  public:
+    DirtyRegionTracker(uint32_t width, uint32_t height, uint32_t tile_size = 32);
+    ~DirtyRegionTracker() = default;
+
+    auto beginFrame() -> void;
+    auto record(const Rect &bounds, uint64_t signature) -> void;
+
+    /**
+     * @brief Diffs the recorded draws against the previous frame
+     *
+     * @return Tile aligned rectangles clamped to the screen that must be cleared and redrawn. The storage is reused
+     * by the next call.
+     */
+    auto endFrame() -> const std::vector<Rect> &;
+
+    /**
+     * @brief Marks the whole screen dirty on the next endFrame, e.g. after a resize or on the first frame
+     */
+    auto invalidate() -> void;
+
+    /**
+     * @brief Retiles for a new screen size, the previous frame is forgotten and the whole screen is dirty
+     */
+    auto resize(uint32_t width, uint32_t height) -> void;
+
+  private:
+    struct DrawRecord
+    {
+        Rect bounds;
+        uint64_t signature;
+    };
+
+    auto markDirty(const Rect &rect) -> void;
+
+    uint32_t width_;
+    uint32_t height_;
+    uint32_t tile_size_;
+    uint32_t tiles_x_;
+    uint32_t tiles_y_;
+    bool invalidated_;
+
+    std::vector<DrawRecord> previous_draws_;
+    std::vector<DrawRecord> current_draws_;
+    std::vector<uint8_t> dirty_tiles_;
+    std::vector<Rect> dirty_rects_;
+};
+
+} // namespace cam3d
+
+#endif // DIRTY_REGION_H
@@ -0,0 +1,84 @@
+/**
+ * @file dynamic_resolution.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-29
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Picks the internal render resolution from the measured raster time and upscales the result to the output
+ *
+ * Raster cost is treated as proportional to the pixel count, so the scale moves by the square root of the ratio
+ * between the budget and a smoothed frame time. A dead band around the budget keeps the size from oscillating, and
+ * render sizes are kept to multiples of 8 so the quad loops of the rasterizer stay aligned.
+ */
+class DynamicResolution
+{
+  public:
+    DynamicResolution(uint32_t output_width, uint32_t output_height, float target_ms, float min_scale = 0.5f);
+    ~DynamicResolution() = default;
+
+    /**
+     * @brief Feeds the raster time of the last frame
+     *
+     * @return true if the render size changed, the frame buffer and rasterizer should then be given the new viewport
+     */
+    auto update(float raster_ms) -> bool;
+
+    /**
+     * @brief Bilinear upscale of the active viewport of src to the whole of dst
+     *
+     * Sample positions follow pixel centers. The column taps and weights are cached per source width, so the per pixel
+     * work is four loads and a fixed point SWAR blend.
+     */
+    auto upscale(const FrameBuffer &src, FrameBuffer &dst) -> void;
+
+    auto setTargetTime(float target_ms) -> void;
+
+    auto getRenderWidth() const -> uint32_t;
+    auto getRenderHeight() const -> uint32_t;
+    auto getScale() const -> float;
+    auto getAverageTime() const -> float;
+
+  private:
+    auto applyScale(float scale) -> bool;
+    auto buildColumns(uint32_t src_width, uint32_t dst_width) -> void;
+
+    struct Tap
+    {
+        uint32_t offset; // Left source column
+        uint32_t step;   // 1, or 0 on the last column so the right tap stays in bounds
+        uint32_t weight; // Weight of the right tap in 1/256
+    };
+
+    uint32_t output_width_;
+    uint32_t output_height_;
+    float target_ms_;
+    float min_scale_;
+    float scale_;
+    float average_ms_;
+    uint32_t render_width_;
+    uint32_t render_height_;
+
+    uint32_t columns_src_width_;
+    uint32_t columns_dst_width_;
+    std::vector<Tap> columns_;
+};
+
+} // namespace cam3d
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -0,0 +1,171 @@
+/**
+ * @file frame_arena.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Bump allocator backed by a list of blocks that are kept alive across resets
+ *
+ * Once the blocks have grown to fit the largest frame, allocating from the arena never touches the global heap again.
+ * Individual deallocations are ignored unless they free the most recent allocation, which is rolled back. A growing
+ * vector allocates its new storage before it frees the old one, so the old storage is never the most recent allocation
+ * and stays in the arena until the next reset or rewind. Reserve up front where the size is known.
+ */
+class LinearArena
+{
+  public:
+    static constexpr size_t kDefaultBlockSize = 1 << 20;
+
+    struct Marker
+    {
+        size_t block;
+        size_t offset;
+    };
+
+    explicit LinearArena(size_t block_size = kDefaultBlockSize);
+    ~LinearArena() = default;
+
+    LinearArena(const LinearArena &) = delete;
+    auto operator=(const LinearArena &) -> LinearArena & = delete;
+
+    auto allocate(size_t bytes, size_t alignment) -> void *;
+    auto deallocate(void *ptr, size_t bytes) -> void;
+
+    auto reset() -> void;
+    auto mark() const -> Marker;
+    auto rewind(const Marker &marker) -> void;
+
+    auto getBlockAllocationCount() const -> size_t;
+
+  private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t block_size_;
+    size_t current_block_;
+    size_t offset_;
+    size_t block_allocation_count_;
+};
+
+/**
+ * @brief Rewinds the arena to where it was on construction when it goes out of scope
+ */
+class ArenaScope
+{
+  public:
+    explicit ArenaScope(LinearArena &arena) : arena_(arena), marker_(arena.mark())
+    {
+    }
+    ~ArenaScope()
+    {
+        arena_.rewind(marker_);
+    }
+
+    ArenaScope(const ArenaScope &) = delete;
+    auto operator=(const ArenaScope &) -> ArenaScope & = delete;
+
+  private:
+    LinearArena &arena_;
+    LinearArena::Marker marker_;
+};
+
+/**
+ * @brief Standard allocator adaptor so containers can draw their storage from a LinearArena
+ *
+ * @tparam T The allocated value type
+ */
+template <typename T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LinearArena &arena) : arena_(&arena)
+    {
+    }
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.getArena())
+    {
+    }
+
+    auto allocate(size_t n) -> T *
+    {
+        return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    auto deallocate(T *ptr, size_t n) -> void
+    {
+        arena_->deallocate(ptr, n * sizeof(T));
+    }
+
+    auto getArena() const -> LinearArena *
+    {
+        return arena_;
+    }
+
+    template <typename U> auto operator==(const ArenaAllocator<U> &other) const -> bool
+    {
+        return arena_ == other.getArena();
+    }
+
+  private:
+    LinearArena *arena_;
+};
+
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * @brief Frame scoped storage with one sub arena per worker thread
+ *
+ * Each thread allocates from its own LinearArena, so no synchronization is needed while rendering. reset() is called
+ * once per frame and only rewinds the arenas.
+ */
+class FrameArena
+{
+  public:
+    explicit FrameArena(size_t thread_count = 1, size_t block_size = LinearArena::kDefaultBlockSize);
+    ~FrameArena() = default;
+
+    auto local(size_t thread_index) -> LinearArena &
+    {
+        assert(thread_index < arenas_.size() && "Thread index out of range");
+        return *arenas_[thread_index];
+    }
+
+    auto reset() -> void;
+
+    /**
+     * @brief Adds or drops sub arenas to match the thread count, the remaining ones keep their blocks
+     */
+    auto setThreadCount(size_t thread_count) -> void;
+
+    auto getThreadCount() const -> size_t;
+    auto getBlockAllocationCount() const -> size_t;
+
+  private:
+    std::vector<std::unique_ptr<LinearArena>> arenas_;
+    size_t block_size_;
+};
+
+} // namespace cam3d
+
+#endif // FRAME_ARENA_H
@@ -13,6 +13,7 @@
 #define FRAME_BUFFER_H
 
 #include <X11/X.h>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -40,10 +41,79 @@ struct ARGB
         return (static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) |
                static_cast<uint32_t>(b);
     }
+
+    static auto fromARGB(const ARGB &color) -> ARGB
+    {
+        return color;
+    }
+    auto toARGB() const -> ARGB
+    {
+        return *this;
+    }
 };
 
 using BufferARGB = std::vector<ARGB>;
 
+/**
+ * @brief 16-bit packed color, 5 bits red, 6 bits green and 5 bits blue, no alpha
+ */
+struct RGB565
+{
+    uint16_t value = 0;
+
+    static auto fromARGB(const ARGB &color) -> RGB565
+    {
+        return RGB565{static_cast<uint16_t>(((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3))};
+    }
+    auto toARGB() const -> ARGB
+    {
+        auto r = static_cast<uint8_t>((value >> 11) & 0x1f);
+        auto g = static_cast<uint8_t>((value >> 5) & 0x3f);
+        auto b = static_cast<uint8_t>(value & 0x1f);
+        return ARGB(255, static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+                    static_cast<uint8_t>((b << 3) | (b >> 2)));
+    }
+};
+
+/**
+ * @brief 8-bit luminance, colors are reduced with the BT.601 luma weights
+ */
+struct Gray8
+{
+    uint8_t value = 0;
+
+    static auto fromARGB(const ARGB &color) -> Gray8
+    {
+        return Gray8{static_cast<uint8_t>((77 * color.r + 150 * color.g + 29 * color.b) >> 8)};
+    }
+    auto toARGB() const -> ARGB
+    {
+        return ARGB(255, value, value, value);
+    }
+};
+
+/**
+ * @brief Axis aligned pixel rectangle, width or height of zero means empty
+ */
+struct Rect
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+
+    auto isEmpty() const -> bool
+    {
+        return width == 0 || height == 0;
+    }
+
+    auto intersects(const Rect &other) const -> bool
+    {
+        return !isEmpty() && !other.isEmpty() && x < other.x + other.width && other.x < x + width &&
+               y < other.y + other.height && other.y < y + height;
+    }
+};
+
 struct COLOR
 {
     ARGB RED{255, 255, 0, 0};
@@ -57,34 +127,68 @@ struct COLOR
     ARGB GRAY{255, 128, 128, 128};
 };
 
-class FrameBuffer
+/**
+ * @brief Color and depth render target
+ *
+ * @tparam Pixel Storage format of the color buffer (ARGB, RGB565 or Gray8). Colors are always passed in as ARGB and
+ * narrowed on write, so narrower formats only cost a conversion at present or export time.
+ */
+template <typename Pixel> class BasicFrameBuffer
 {
   public:
-    FrameBuffer(uint32_t width, uint32_t height)
-        : width_(width), height_(height), total_size_(width * height), buffer_(total_size_, ARGB()),
+    using PixelType = Pixel;
+
+    BasicFrameBuffer(uint32_t width, uint32_t height)
+        : width_(width), height_(height), total_size_(width * height), buffer_(total_size_, Pixel()),
           depth_buffer_(total_size_, std::numeric_limits<float>::max())
     {
         assert(width > 0 && height > 0 && "Width and height must be greater than zero");
     }
-    ~FrameBuffer() = default;
+    ~BasicFrameBuffer() = default;
+
+    /**
+     * @brief Changes the active resolution without reallocating
+     *
+     * The buffers keep the size they were constructed with, so the new viewport must not hold more pixels. Rows stay
+     * tightly packed with a stride of the new width, and the contents are undefined until the next clear.
+     */
+    auto setViewport(uint32_t width, uint32_t height) -> void
+    {
+        assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+        assert(static_cast<size_t>(width) * height <= buffer_.size() && "Viewport exceeds the allocated size");
+        width_ = width;
+        height_ = height;
+        total_size_ = static_cast<size_t>(width) * height;
+    }
 
     auto clear() -> void
     {
-        std::fill(buffer_.begin(), buffer_.end(), ARGB());
-        std::fill(depth_buffer_.begin(), depth_buffer_.end(), std::numeric_limits<uint32_t>::max());
+        std::fill_n(buffer_.begin(), total_size_, Pixel());
+        std::fill_n(depth_buffer_.begin(), total_size_, std::numeric_limits<uint32_t>::max());
     }
 
     auto clear(const ARGB &color) -> void
     {
-        std::fill(buffer_.begin(), buffer_.end(), color);
-        std::fill(depth_buffer_.begin(), depth_buffer_.end(), std::numeric_limits<uint32_t>::max());
+        std::fill_n(buffer_.begin(), total_size_, Pixel::fromARGB(color));
+        std::fill_n(depth_buffer_.begin(), total_size_, std::numeric_limits<uint32_t>::max());
+    }
+
+    auto clear(const Rect &rect, const ARGB &color) -> void
+    {
+        assert(rect.x + rect.width <= width_ && rect.y + rect.height <= height_ && "Rect out of bounds");
+        for (uint32_t y = rect.y; y < rect.y + rect.height; ++y)
+        {
+            size_t index = y * width_ + rect.x;
+            std::fill_n(buffer_.begin() + index, rect.width, Pixel::fromARGB(color));
+            std::fill_n(depth_buffer_.begin() + index, rect.width, std::numeric_limits<uint32_t>::max());
+        }
     }
 
     auto setPixel(uint32_t x, uint32_t y, const ARGB &pixel) -> void
     {
         assert(x < width_ && y < height_ && "Pixel coordinates out of bounds");
         size_t index = y * width_ + x;
-        buffer_[index] = pixel;
+        buffer_[index] = Pixel::fromARGB(pixel);
     }
 
     auto setPixel(uint32_t x, uint32_t y, uint32_t z, const ARGB &pixel) -> void
@@ -93,7 +197,7 @@ class FrameBuffer
         size_t index = y * width_ + x;
         if (z < depth_buffer_[index])
         {
-            buffer_[index] = pixel;
+            buffer_[index] = Pixel::fromARGB(pixel);
             depth_buffer_[index] = z;
         }
     }
@@ -105,19 +209,30 @@ class FrameBuffer
         return depth_buffer_[index];
     }
 
-    auto getPixel(uint32_t x, uint32_t y) const -> ARGB
+    auto getPixel(uint32_t x, uint32_t y) const -> Pixel
     {
         assert(x < width_ && y < height_ && "Pixel coordinates out of bounds");
         size_t index = y * width_ + x;
         return buffer_[index];
     }
 
-    auto getBuffer() -> BufferARGB &
+    auto getWidth() const -> uint32_t
+    {
+        return width_;
+    }
+
+    auto getHeight() const -> uint32_t
+    {
+        return height_;
+    }
+
+    /// @note The buffers span the allocated size, only the first getWidth() * getHeight() entries are in use
+    auto getBuffer() -> std::vector<Pixel> &
     {
         return buffer_;
     }
 
-    auto getBuffer() const -> const BufferARGB &
+    auto getBuffer() const -> const std::vector<Pixel> &
     {
         return buffer_;
     }
@@ -136,9 +251,14 @@ class FrameBuffer
     uint32_t width_;
     uint32_t height_;
     size_t total_size_;
-    BufferARGB buffer_;
+    std::vector<Pixel> buffer_;
     std::vector<float> depth_buffer_;
-}; // FrameBuffer class definition
+}; // BasicFrameBuffer class definition
+
+using FrameBuffer = BasicFrameBuffer<ARGB>;
+using FrameBufferRGB565 = BasicFrameBuffer<RGB565>;
+using FrameBufferGray8 = BasicFrameBuffer<Gray8>;
+
 
 } // namespace cam3d
 
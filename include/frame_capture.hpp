@@ -0,0 +1,130 @@
+/**
+ * @file frame_capture.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <frame_buffer.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cam3d
+{
+
+enum class CaptureFormat
+{
+    PpmSequence, // One binary PPM per frame, frame_000000.ppm, ...
+    Y4mVideo     // A single raw YUV4MPEG2 stream in 4:4:4
+};
+
+enum class CaptureOverflow
+{
+    Block, // submit() waits for the writer when every buffer is in flight
+    Drop   // submit() discards the frame instead
+};
+
+struct CaptureSettings
+{
+    std::string output_path; // Directory for sequences, file name for Y4M
+    CaptureFormat format = CaptureFormat::PpmSequence;
+    bool export_depth = false; // Also write 16-bit PGM depth maps, depth_000000.pgm, next to output_path
+    uint32_t frame_rate = 60;
+    size_t queue_depth = 4;
+    CaptureOverflow overflow = CaptureOverflow::Block;
+};
+
+/**
+ * @brief Streams frame buffers to disk from a background thread
+ *
+ * submit() only copies the frame into one of queue_depth recycled buffers, all encoding and file I/O happens on the
+ * writer thread, so the render loop never waits on the disk unless the queue is full and the overflow policy is Block.
+ */
+class FrameCapture
+{
+  public:
+    FrameCapture(uint32_t width, uint32_t height, CaptureSettings settings);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture &) = delete;
+    auto operator=(const FrameCapture &) -> FrameCapture & = delete;
+
+    /**
+     * @brief Queues a copy of the frame for writing, converted to ARGB8888 on the way into the recycled buffer
+     *
+     * Instantiated for ARGB, RGB565 and Gray8 frame buffers, so low bit depth and monochrome targets are captured
+     * without an intermediate ARGB render.
+     *
+     * @return false if the frame was dropped because the queue was full
+     */
+    template <typename Pixel> auto submit(const BasicFrameBuffer<Pixel> &fb) -> bool;
+
+    /**
+     * @brief Blocks until every queued frame has been written
+     */
+    auto flush() -> void;
+
+    auto getWrittenFrameCount() const -> uint64_t;
+    auto getDroppedFrameCount() const -> uint64_t;
+    auto hasError() const -> bool;
+
+  private:
+    struct CaptureFrame
+    {
+        std::vector<uint32_t> color; // Packed ARGB8888, see convertToARGB8888
+        std::vector<float> depth;
+        uint64_t index;
+    };
+
+    auto acquireFrame() -> CaptureFrame *;
+    auto queueFrame(CaptureFrame *frame) -> void;
+
+    auto run() -> void;
+    auto writeFrame(const CaptureFrame &frame) -> bool;
+    auto writePpm(const CaptureFrame &frame) -> bool;
+    auto writeY4m(const CaptureFrame &frame) -> bool;
+    auto writeDepthPgm(const CaptureFrame &frame) -> bool;
+
+    uint32_t width_;
+    uint32_t height_;
+    CaptureSettings settings_;
+
+    std::vector<std::unique_ptr<CaptureFrame>> frames_;
+    std::vector<CaptureFrame *> free_frames_;
+    std::deque<CaptureFrame *> pending_frames_;
+    size_t in_flight_;
+    uint64_t next_index_;
+    bool stopping_;
+
+    std::mutex mutex_;
+    std::condition_variable frame_freed_;
+    std::condition_variable frame_pending_;
+
+    std::ofstream video_;
+    std::vector<uint8_t> scratch_;
+
+    std::atomic<uint64_t> written_count_;
+    std::atomic<uint64_t> dropped_count_;
+    std::atomic<bool> error_;
+
+    std::thread writer_;
+};
+
+} // namespace cam3d
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,123 @@
+/**
+ * @file frame_scheduler.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-05-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Frame time percentiles over the rolling window, all in milliseconds
+ */
+struct FrameStats
+{
+    float p50;
+    float p95;
+    float p99;
+    float work;  // Work time of the last frame, without the pacing wait
+    size_t samples;
+};
+
+/**
+ * @brief Fixed bucket histogram over the last window_size frame times
+ *
+ * Adding a sample and evicting the oldest one are O(1), a percentile walks the buckets once. Percentiles are reported
+ * as the upper edge of their bucket, and times past the last bucket are reported as the histogram range.
+ */
+class FrameTimeHistogram
+{
+  public:
+    static constexpr float kBucketWidthMs = 0.1f;
+    static constexpr size_t kBucketCount = 1000;
+
+    explicit FrameTimeHistogram(size_t window_size = 240);
+    ~FrameTimeHistogram() = default;
+
+    auto add(float milliseconds) -> void;
+
+    /**
+     * @param fraction In [0, 1], e.g. 0.99 for p99
+     */
+    auto getPercentile(float fraction) const -> float;
+
+    auto getBuckets() const -> const std::vector<uint32_t> &;
+    auto getSampleCount() const -> size_t;
+    auto clear() -> void;
+
+  private:
+    static auto bucketOf(float milliseconds) -> size_t;
+
+    std::vector<uint32_t> buckets_;
+    std::vector<uint16_t> window_;
+    size_t next_;
+    size_t count_;
+};
+
+/**
+ * @brief Paces the render loop to a target rate from the measured work time
+ *
+ * Frame deadlines advance by a fixed period, so a short frame does not shorten the next one. Waiting sleeps for most
+ * of the remaining time and spins for the rest, with the spin margin tracking how late the OS wakes the thread up.
+ * A frame that misses its deadline moves the schedule instead of rushing the following frames to catch up.
+ */
+class FrameScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FrameScheduler(float target_rate = 60.0f, size_t window_size = 240);
+    ~FrameScheduler() = default;
+
+    /// @note Call at the start of the frame work
+    auto beginFrame() -> void;
+
+    /**
+     * @brief Records the work time, waits until the frame deadline unless uncapped and records the frame time
+     */
+    auto endFrame() -> void;
+
+    auto setTargetRate(float frames_per_second) -> void;
+
+    /**
+     * @brief Uncapped frames never wait, useful to measure the real throughput of the renderer
+     */
+    auto setUncapped(bool uncapped) -> void;
+    auto isUncapped() const -> bool;
+
+    auto getStats() const -> FrameStats;
+    auto getHistogram() const -> const FrameTimeHistogram &;
+    auto getTargetRate() const -> float;
+
+  private:
+    auto waitUntil(Clock::time_point deadline) -> void;
+
+    Clock::duration period_;
+    bool uncapped_;
+    bool started_;
+
+    Clock::time_point work_start_;
+    Clock::time_point last_frame_end_;
+    Clock::time_point deadline_;
+    Clock::duration spin_margin_;
+    float work_ms_;
+
+    FrameTimeHistogram histogram_;
+};
+
+} // namespace cam3d
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,83 @@
+/**
+ * @file mesh.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-24
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector3.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Sphere enclosing every vertex of a mesh, used for coarse culling
+ */
+struct BoundingSphere
+{
+    Vector3<float> center;
+    float radius;
+};
+
+/**
+ * @brief Indexed triangle list, every three indices form one triangle
+ */
+struct Mesh
+{
+    std::vector<Vector3<float>> vertices;
+    std::vector<uint32_t> indices;
+
+    auto getTriangleCount() const -> size_t
+    {
+        return indices.size() / 3;
+    }
+
+    /**
+     * @brief Sphere around the center of the axis aligned bounds, not minimal but cheap and never too small
+     */
+    auto getBoundingSphere() const -> BoundingSphere
+    {
+        if (vertices.empty())
+        {
+            return BoundingSphere{Vector3<float>(0, 0, 0), 0};
+        }
+        float min_x = vertices[0].x(), min_y = vertices[0].y(), min_z = vertices[0].z();
+        float max_x = min_x, max_y = min_y, max_z = min_z;
+        for (const auto &v : vertices)
+        {
+            min_x = std::min(min_x, v.x());
+            min_y = std::min(min_y, v.y());
+            min_z = std::min(min_z, v.z());
+            max_x = std::max(max_x, v.x());
+            max_y = std::max(max_y, v.y());
+            max_z = std::max(max_z, v.z());
+        }
+        const float cx = (min_x + max_x) / 2;
+        const float cy = (min_y + max_y) / 2;
+        const float cz = (min_z + max_z) / 2;
+        float radius_squared = 0;
+        for (const auto &v : vertices)
+        {
+            const float dx = v.x() - cx;
+            const float dy = v.y() - cy;
+            const float dz = v.z() - cz;
+            radius_squared = std::max(radius_squared, dx * dx + dy * dy + dz * dz);
+        }
+        return BoundingSphere{Vector3<float>(cx, cy, cz), std::sqrt(radius_squared)};
+    }
+};
+
+} // namespace cam3d
+
+#endif // MESH_H
@@ -0,0 +1,165 @@
+/**
+ * @file multi_view.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-24
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef MULTI_VIEW_H
+#define MULTI_VIEW_H
+
+#include <camera.hpp>
+#include <frame_buffer.hpp>
+#include <memory>
+#include <mesh.hpp>
+#include <rasterizer.hpp>
+#include <shader.hpp>
+#include <thread_pool.hpp>
+#include <transform.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief One camera of a rig and the frame buffer it renders into, sized like the camera intrinsics
+ */
+struct ViewSetup
+{
+    PinholeCamera camera;
+    FrameBuffer *target;
+};
+
+/**
+ * @brief Renders the same geometry from many cameras in one pass
+ *
+ * The world transform runs once per draw and is shared by every view. Clipping, projection, culling and rasterization
+ * then run per view, with the views spread over the thread pool. Triangles crossing the near or far plane of a camera
+ * are clipped in its camera space, so geometry close to a rig camera is cut rather than dropped.
+ */
+class MultiViewRenderer
+{
+  public:
+    explicit MultiViewRenderer(std::shared_ptr<ThreadPool> thread_pool = nullptr);
+    ~MultiViewRenderer() = default;
+
+    auto drawMesh(const Mesh &mesh, const Transform &model_to_world, const std::vector<ViewSetup> &views,
+                  const ARGB &color) -> void
+    {
+        drawMesh(mesh, model_to_world, views, FlatFragmentShader{color});
+    }
+
+    /**
+     * @brief Draws a mesh into every view
+     *
+     * @param fragment_shader Called concurrently for different views, so it must not mutate shared state
+     */
+    template <typename FS>
+        requires FragmentShader<FS, NoVarying>
+    auto drawMesh(const Mesh &mesh, const Transform &model_to_world, const std::vector<ViewSetup> &views,
+                  FS &&fragment_shader) -> void;
+
+  private:
+    auto transformToWorld(const Mesh &mesh, const Transform &model_to_world) -> void;
+    auto prepareView(size_t view_index, const ViewSetup &view) -> Rasterizer &;
+    auto isOnScreen(const Vector3<float> &p0, const Vector3<float> &p1, const Vector3<float> &p2,
+                    const CameraIntrinsics &intrinsics) const -> bool;
+
+    // A triangle clipped by two parallel planes has at most five corners
+    static constexpr size_t kMaxClippedVertices = 5;
+
+    /**
+     * @brief Sutherland–Hodgman clip of a camera space triangle against near <= z <= far
+     *
+     * @return Number of polygon corners written to clipped, 0 if nothing is left
+     */
+    static auto clipToDepthRange(const Vector3<float> (&triangle)[3], float near_plane, float far_plane,
+                                 Vector3<float> (&clipped)[kMaxClippedVertices]) -> size_t;
+
+    std::shared_ptr<ThreadPool> thread_pool_;
+    std::vector<Vector3<float>> world_vertices_;
+    std::vector<std::unique_ptr<Rasterizer>> rasterizers_;
+    std::vector<std::vector<Vector3<float>>> camera_vertices_;
+    std::vector<std::vector<Vector3<float>>> screen_vertices_;
+};
+
+template <typename FS>
+    requires FragmentShader<FS, NoVarying>
+auto MultiViewRenderer::drawMesh(const Mesh &mesh, const Transform &model_to_world,
+                                 const std::vector<ViewSetup> &views, FS &&fragment_shader) -> void
+{
+    if (views.empty() || mesh.indices.empty())
+    {
+        return;
+    }
+
+    // Shared front end
+    transformToWorld(mesh, model_to_world);
+    for (size_t v = 0; v < views.size(); ++v)
+    {
+        prepareView(v, views[v]);
+    }
+
+    // Per view back end, each view owns its rasterizer and target so views never touch shared state
+    thread_pool_->parallelFor(views.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t v = begin; v < end; ++v)
+        {
+            const auto &view = views[v];
+            const auto &camera = view.camera;
+            const auto &intrinsics = camera.getIntrinsics();
+            const auto &world_to_camera = camera.getExtrinsics();
+            const float near_plane = camera.getNearPlane();
+            const float far_plane = camera.getFarPlane();
+            auto &camera_space = camera_vertices_[v];
+            auto &screen = screen_vertices_[v];
+            for (size_t i = 0; i < world_vertices_.size(); ++i)
+            {
+                camera_space[i] = world_to_camera.apply(world_vertices_[i]);
+                screen[i] = camera.projectFromCamera(camera_space[i]);
+            }
+
+            auto &rasterizer = *rasterizers_[v];
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+            {
+                const uint32_t i0 = mesh.indices[t];
+                const uint32_t i1 = mesh.indices[t + 1];
+                const uint32_t i2 = mesh.indices[t + 2];
+                auto in_depth = [&](uint32_t i) {
+                    return camera_space[i].z() >= near_plane && camera_space[i].z() <= far_plane;
+                };
+                if (in_depth(i0) && in_depth(i1) && in_depth(i2))
+                {
+                    if (isOnScreen(screen[i0], screen[i1], screen[i2], intrinsics))
+                    {
+                        rasterizer.drawTriangle(screen[i0], screen[i1], screen[i2], *view.target,
+                                                PassThroughVertexShader{}, fragment_shader);
+                    }
+                    continue;
+                }
+
+                // Crosses a clipping plane, draw the clipped polygon as a fan
+                const Vector3<float> triangle[3] = {camera_space[i0], camera_space[i1], camera_space[i2]};
+                Vector3<float> clipped[kMaxClippedVertices];
+                const size_t corners = clipToDepthRange(triangle, near_plane, far_plane, clipped);
+                for (size_t k = 1; k + 1 < corners; ++k)
+                {
+                    const auto p0 = camera.projectFromCamera(clipped[0]);
+                    const auto p1 = camera.projectFromCamera(clipped[k]);
+                    const auto p2 = camera.projectFromCamera(clipped[k + 1]);
+                    if (isOnScreen(p0, p1, p2, intrinsics))
+                    {
+                        rasterizer.drawTriangle(p0, p1, p2, *view.target, PassThroughVertexShader{}, fragment_shader);
+                    }
+                }
+            }
+        }
+    });
+}
+
+} // namespace cam3d
+
+#endif // MULTI_VIEW_H
@@ -0,0 +1,70 @@
+/**
+ * @file pixel_format.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-28
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef PIXEL_FORMAT_H
+#define PIXEL_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Converts pixels to packed ARGB8888, i.e. 0xAARRGGBB in a native uint32 (SDL_PIXELFORMAT_ARGB8888)
+ *
+ * The loops are written without branches or cross lane dependencies so they vectorize, this is meant to run once per
+ * frame right before present or export.
+ */
+auto convertToARGB8888(const ARGB *src, uint32_t *dst, size_t count) -> void;
+auto convertToARGB8888(const RGB565 *src, uint32_t *dst, size_t count) -> void;
+auto convertToARGB8888(const Gray8 *src, uint32_t *dst, size_t count) -> void;
+
+/**
+ * @brief Bilinear blend of four packed 8-bit-per-channel pixels, any channel order
+ *
+ * Branch free SWAR: two channels share each 32-bit lane and the four weights sum to 256, so no channel can overflow
+ * into its neighbour.
+ *
+ * @param p00, p01, p10, p11 Top left, top right, bottom left and bottom right taps
+ * @param fx Weight of the right taps in 1/256
+ * @param fy Weight of the bottom taps in 1/256
+ */
+inline auto blendBilinear(uint32_t p00, uint32_t p01, uint32_t p10, uint32_t p11, uint32_t fx, uint32_t fy)
+    -> uint32_t
+{
+    const uint32_t w00 = ((256 - fx) * (256 - fy)) >> 8;
+    const uint32_t w01 = (fx * (256 - fy)) >> 8;
+    const uint32_t w10 = ((256 - fx) * fy) >> 8;
+    const uint32_t w11 = 256 - w00 - w01 - w10;
+
+    const uint32_t even = (w00 * (p00 & 0x00ff00ff) + w01 * (p01 & 0x00ff00ff) + w10 * (p10 & 0x00ff00ff) +
+                           w11 * (p11 & 0x00ff00ff)) >>
+                          8;
+    const uint32_t odd = w00 * ((p00 >> 8) & 0x00ff00ff) + w01 * ((p01 >> 8) & 0x00ff00ff) +
+                         w10 * ((p10 >> 8) & 0x00ff00ff) + w11 * ((p11 >> 8) & 0x00ff00ff);
+    return (even & 0x00ff00ff) | (odd & 0xff00ff00);
+}
+
+/**
+ * @brief Converts a whole frame buffer, dst is resized to the pixel count
+ */
+template <typename Pixel> auto convertToARGB8888(const BasicFrameBuffer<Pixel> &fb, std::vector<uint32_t> &dst) -> void
+{
+    dst.resize(static_cast<size_t>(fb.getWidth()) * fb.getHeight());
+    convertToARGB8888(fb.getBuffer().data(), dst.data(), dst.size());
+}
+
+} // namespace cam3d
+
+#endif // PIXEL_FORMAT_H
@@ -0,0 +1,88 @@
+/**
+ * @file point_splatter.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-20
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef POINT_SPLATTER_H
+#define POINT_SPLATTER_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <limits>
+#include <memory>
+
+namespace cam3d
+{
+
+/**
+ * @brief Lock free visibility buffer for splatting points from many threads at once
+ *
+ * Every pixel is a 64-bit word holding the depth bits in the upper half and the ARGB color in the lower half.
+ * Non-negative floats order like their bit patterns, so an atomic minimum on the packed word keeps the nearest point
+ * and, on equal depth, the smallest color, which keeps the result independent of thread scheduling.
+ */
+class PointSplatter
+{
+  public:
+    static constexpr uint64_t kEmpty = std::numeric_limits<uint64_t>::max();
+
+    PointSplatter(uint32_t width, uint32_t height);
+    ~PointSplatter() = default;
+
+    /**
+     * @brief Changes the active resolution without reallocating, like BasicFrameBuffer::setViewport
+     *
+     * The new viewport must not hold more pixels than the splatter was constructed with. resolve() leaves every word
+     * empty, so no clear is needed as long as the viewport only changes between draws.
+     */
+    auto setViewport(uint32_t width, uint32_t height) -> void;
+
+    auto splat(uint32_t x, uint32_t y, float depth, uint32_t argb) -> void
+    {
+        const uint64_t packed = (static_cast<uint64_t>(std::bit_cast<uint32_t>(depth)) << 32) | argb;
+        auto &word = packed_[static_cast<size_t>(y) * width_ + x];
+        uint64_t current = word.load(std::memory_order_relaxed);
+        while (packed < current && !word.compare_exchange_weak(current, packed, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @brief Depth tests the splatted rows [y_begin, y_end) against the frame buffer and clears them for reuse
+     */
+    auto resolve(FrameBuffer &fb, uint32_t y_begin, uint32_t y_end) -> void;
+
+    auto getWidth() const -> uint32_t
+    {
+        return width_;
+    }
+
+    auto getHeight() const -> uint32_t
+    {
+        return height_;
+    }
+
+    auto getCapacity() const -> size_t
+    {
+        return capacity_;
+    }
+
+  private:
+    uint32_t width_;
+    uint32_t height_;
+    size_t capacity_;
+    std::unique_ptr<std::atomic<uint64_t>[]> packed_;
+};
+
+} // namespace cam3d
+
+#endif // POINT_SPLATTER_H
@@ -15,13 +15,32 @@
 #include <algorithm.hpp>
 #include <array>
 #include <cstddef>
+#include <dirty_region.hpp>
+#include <frame_arena.hpp>
 #include <frame_buffer.hpp>
+#include <cmath>
 #include <memory>
+#include <mesh.hpp>
+#include <point_splatter.hpp>
+#include <shader.hpp>
+#include <thread_pool.hpp>
+#include <transform.hpp>
+#include <type_traits>
 #include <vector3.hpp>
 
 namespace cam3d
 {
 
+/**
+ * @brief Depth comparison used by the shaded triangle kernel
+ */
+enum class DepthTest
+{
+    Less,      // Default, shade and write when nearer than the stored depth
+    LessEqual, // Like Less but also passes on equal depth
+    Equal      // Shade only where the stored depth matches exactly, without writing it. Used after a depth prepass.
+};
+
 class Rasterizer
 {
   public:
@@ -29,17 +48,208 @@ class Rasterizer
 
     ~Rasterizer() = default;
 
-    auto drawLine(const Vector3<float> &p_start, const Vector3<float> &p_end, FrameBuffer &fb,
+    /**
+     * @brief Releases all transient storage of the previous frame, call once before issuing a frame's draws
+     */
+    auto beginFrame() -> void;
+
+    /**
+     * @brief Frame scoped storage with one sub arena per thread of the pool, indexed by the parallelFor worker index
+     */
+    auto getFrameArena() -> FrameArena &;
+
+    /**
+     * @brief Changes the render resolution in place, keeping the field of view and clipping planes
+     */
+    auto setViewport(uint32_t width, uint32_t height) -> void;
+
+    auto getWidth() const -> uint32_t;
+    auto getHeight() const -> uint32_t;
+
+    /**
+     * @brief Sets the projection used by projectBasicPerspective and drawPoints
+     *
+     * @param fov_degrees Vertical field of view in degrees. Use PinholeCamera to match a calibrated camera instead.
+     */
+    auto setPerspective(float fov_degrees, float near_plane, float far_plane) -> void;
+
+    /**
+     * @brief Restricts all following draws to the given rectangle, used to redraw dirty regions only
+     */
+    auto setScissor(const Rect &rect) -> void;
+    auto resetScissor() -> void;
+
+    /**
+     * @brief Screen space pixel bounds of a projected triangle, clamped to the screen
+     */
+    auto getTriangleBounds(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3) const
+        -> Rect;
+
+    /**
+     * @brief Attaches a tracker that the following draws record into instead of rasterizing, nullptr detaches it
+     *
+     * While a tracker is attached every draw call records its screen bounds and a signature of its inputs and returns
+     * without touching the frame buffer. Issue a frame's draws once with the tracker attached, detach it and issue them
+     * again scissored to each dirty rectangle, so the recorded bounds always come from the draws themselves. Shader
+     * objects are hashed when they are trivially copyable, a shader that changes its output through a reference needs
+     * DirtyRegionTracker::invalidate.
+     */
+    auto setDirtyRegionTracker(DirtyRegionTracker *tracker) -> void;
+    auto getDirtyRegionTracker() const -> DirtyRegionTracker *;
+
+    /// @note The draw calls accept every frame buffer pixel format, colors are narrowed on write
+    template <typename Pixel>
+    auto drawLine(const Vector3<float> &p_start, const Vector3<float> &p_end, BasicFrameBuffer<Pixel> &fb,
                   const ARGB &color) -> void;
 
-    auto drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3, FrameBuffer &fb,
-                      const ARGB &color) -> void;
+    template <typename Pixel>
+    auto drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
+                      BasicFrameBuffer<Pixel> &fb, const ARGB &color) -> void;
+
+    /**
+     * @brief Rasterizes only the depth of a screen space triangle, the color buffer is never touched
+     *
+     * Coverage and depth are computed exactly like the shaded kernel, so a following color pass with DepthTest::Equal
+     * and the same vertices shades every visible pixel once.
+     */
+    template <typename Pixel>
+    auto drawTriangleDepth(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
+                           BasicFrameBuffer<Pixel> &fb) -> void;
+
+    auto setDepthTest(DepthTest depth_test) -> void;
+    auto getDepthTest() const -> DepthTest;
+
+    template <typename VertexIn, typename Pixel, typename VS, typename FS>
+        requires VertexShader<VS, VertexIn> &&
+                 FragmentShader<FS, std::remove_cvref_t<VertexShaderVarying<VS, VertexIn>>>
+    auto drawTriangle(const VertexIn &v1, const VertexIn &v2, const VertexIn &v3, BasicFrameBuffer<Pixel> &fb,
+                      VS &&vertex_shader, FS &&fragment_shader) -> void;
+
+    /**
+     * @brief Draws count copies of a mesh, each placed by its own model to view transform and flat shaded in its color
+     *
+     * Instances whose bounding sphere lies outside the view frustum are dropped before any vertex is touched. The
+     * survivors are transformed and projected eight instances at a time, one SIMD lane per instance, which keeps the
+     * lanes full even for meshes with a handful of vertices. Triangles with a vertex outside the near or far plane are
+     * rejected as a whole.
+     *
+     * @param instance_transforms One model to view transform per instance, projected like projectBasicPerspective
+     * @param instance_colors One color per instance
+     */
+    template <typename Pixel>
+    auto drawInstanced(const Mesh &mesh, const Transform *instance_transforms, const ARGB *instance_colors,
+                       size_t count, BasicFrameBuffer<Pixel> &fb) -> void;
+
+    /**
+     * @brief Projects view space points in parallel and splats each as a point_size x point_size square
+     *
+     * Visibility between threads is resolved without locks in a PointSplatter, which is then depth tested into fb.
+     *
+     * @param colors One color per point
+     */
+    auto drawPoints(const Vector3<float> *points, const ARGB *colors, size_t count, FrameBuffer &fb,
+                    uint32_t point_size = 1) -> void;
+
+    /**
+     * @brief Shares a thread pool between rasterizers, one with hardware_concurrency threads is created on demand
+     */
+    auto setThreadPool(std::shared_ptr<ThreadPool> thread_pool) -> void;
 
     template <typename T> auto normalizeToScreen(const Vector3<T> &v) -> Vector3<T>;
     template <typename T> auto projectOrtographic(const Vector3<T> &v) -> Vector3<T>;
     template <typename T> auto projectBasicPerspective(const Vector3<T> &v) -> Vector3<T>;
 
   private:
+    // Pixels are rasterized in horizontal runs of this many lanes so the coverage and depth math vectorizes.
+    static constexpr uint32_t kQuadWidth = 8;
+
+    struct QuadCoverage
+    {
+        float w0[kQuadWidth];
+        float w1[kQuadWidth];
+        float w2[kQuadWidth];
+        float z[kQuadWidth];
+        bool inside[kQuadWidth];
+    };
+
+    enum class DrawKind : uint8_t
+    {
+        Line,
+        Triangle,
+        TriangleDepth,
+        Shaded,
+        Points
+    };
+
+    struct TriangleSetup
+    {
+        float inv_area;
+        bool top_left[3]; // Per edge opposite a, b and c, whether pixel centres exactly on it are covered
+        uint32_t x_first;
+        uint32_t x_last;
+        uint32_t y_first;
+        uint32_t y_last;
+    };
+
+    /**
+     * @brief projectBasicPerspective folded into a few constants, for loops that project many points at once
+     */
+    struct BatchProjection
+    {
+        float x_scale;
+        float y_scale;
+        float w_scale;
+        float half_width;
+        float half_height;
+        float near_plane;
+        float far_plane;
+        float inv_depth_range;
+
+        /// @return Whether z lies between the clipping planes, the screen position is only meaningful if it does
+        auto project(float x, float y, float z, float &sx, float &sy, float &sz) const -> bool
+        {
+            const float inv_w = 1.0f / (w_scale * z);
+            sx = (x_scale * x * inv_w + 1) * half_width;
+            sy = (1 - y_scale * y * inv_w) * half_height;
+            sz = (z - near_plane) * inv_depth_range;
+            return (z >= near_plane) & (z <= far_plane);
+        }
+    };
+
+    auto getBatchProjection() const -> BatchProjection;
+
+    /**
+     * @brief The shared pool, created on first use. The frame arena always has a sub arena per pool thread.
+     */
+    auto getThreadPool() -> ThreadPool &;
+
+    /**
+     * @brief Signature every recorded draw starts from, the depth test changes the pixels as much as the vertices do
+     */
+    auto beginSignature(DrawKind kind) const -> DrawSignature;
+
+    /// @note Stateless shaders add nothing, and references captured by a shader are hashed by address
+    template <typename T> static auto addToSignature(DrawSignature &signature, const T &value) -> void
+    {
+        if constexpr (std::is_trivially_copyable_v<T> && !std::is_empty_v<T>)
+        {
+            signature.add(value);
+        }
+    }
+
+    auto setupTriangle(const Vector3<float> &pa, const Vector3<float> &pb, const Vector3<float> &pc,
+                       TriangleSetup &setup) const -> bool;
+
+    /**
+     * @brief Computes barycentric weights, interpolated depth and coverage for kQuadWidth pixels starting at (x, y)
+     *
+     * Defined out of line in the library, so drawTriangleDepth and a shaded kernel instantiated by client code run the
+     * same compiled arithmetic whatever flags the client builds with. A depth prepass followed by DepthTest::Equal
+     * relies on both rounding identically.
+     */
+    static auto computeQuadCoverage(const Vector3<float> &pa, const Vector3<float> &pb, const Vector3<float> &pc,
+                                    const TriangleSetup &setup, uint32_t x, uint32_t y, QuadCoverage &quad) -> void;
+
     uint32_t width_;
     uint32_t height_;
     float aspect_ratio_;
@@ -48,10 +258,18 @@ class Rasterizer
     float near_plane_;
     float far_plane_;
     std::array<std::array<float, 4>, 4> projection_matrix_;
+    Rect scissor_;
+    DepthTest depth_test_;
+    DirtyRegionTracker *dirty_tracker_;
 
     std::unique_ptr<CohenSutherland> clipper_;
     std::unique_ptr<Bresenham> bresenham_;
     std::unique_ptr<IntersectionCalculator> intersectionCalculator_;
+
+    FrameArena frame_arena_;
+
+    std::shared_ptr<ThreadPool> thread_pool_;
+    std::unique_ptr<PointSplatter> point_splatter_;
 };
 
 /**
@@ -122,5 +340,148 @@ template <typename T> auto Rasterizer::projectBasicPerspective(const Vector3<T>
     return Vector3<T>(x, y, z);
 }
 
+/**
+ * @brief Computes the scissored pixel bounds and reciprocal area shared by all triangle kernels
+ *
+ * @return false if the triangle is degenerate or covers no pixel inside the scissor rectangle
+ */
+inline auto Rasterizer::setupTriangle(const Vector3<float> &pa, const Vector3<float> &pb, const Vector3<float> &pc,
+                                      TriangleSetup &setup) const -> bool
+{
+    const float area = (pb.x() - pa.x()) * (pc.y() - pa.y()) - (pb.y() - pa.y()) * (pc.x() - pa.x());
+    if (area == 0.0f)
+    {
+        return false; // Degenerate triangle
+    }
+
+    const float min_x =
+        std::max(static_cast<float>(scissor_.x), std::floor(std::min({pa.x(), pb.x(), pc.x()})));
+    const float max_x = std::min(static_cast<float>(scissor_.x + scissor_.width) - 1,
+                                 std::ceil(std::max({pa.x(), pb.x(), pc.x()})));
+    const float min_y =
+        std::max(static_cast<float>(scissor_.y), std::floor(std::min({pa.y(), pb.y(), pc.y()})));
+    const float max_y = std::min(static_cast<float>(scissor_.y + scissor_.height) - 1,
+                                 std::ceil(std::max({pa.y(), pb.y(), pc.y()})));
+    if (min_x > max_x || min_y > max_y)
+    {
+        return false; // Triangle is completely outside the scissor rectangle
+    }
+
+    setup.inv_area = 1.0f / area;
+
+    // Top left fill rule: a pixel centre on an edge shared by two triangles belongs to exactly one of them. With y
+    // pointing down, an edge is a left edge when the inside lies to its right and a top edge when it is horizontal with
+    // the inside below it. The inward normal of each edge is flipped by the winding, like the weights are.
+    const float winding = area > 0.0f ? 1.0f : -1.0f;
+    auto is_top_left = [winding](const Vector3<float> &from, const Vector3<float> &to) {
+        const float normal_x = -(to.y() - from.y()) * winding;
+        const float normal_y = (to.x() - from.x()) * winding;
+        return normal_x > 0.0f || (normal_x == 0.0f && normal_y > 0.0f);
+    };
+    setup.top_left[0] = is_top_left(pb, pc);
+    setup.top_left[1] = is_top_left(pc, pa);
+    setup.top_left[2] = is_top_left(pa, pb);
+    setup.x_first = static_cast<uint32_t>(min_x);
+    setup.x_last = static_cast<uint32_t>(max_x);
+    setup.y_first = static_cast<uint32_t>(min_y);
+    setup.y_last = static_cast<uint32_t>(max_y);
+    return true;
+}
+
+/**
+ * @brief Draws a filled triangle through user supplied vertex and fragment shader functors
+ *
+ * The shaders are template parameters so both stages inline into the raster loop. The fragment shader only runs for
+ * pixels that pass the depth test. Varyings are interpolated perspective correct when the vertex shader fills in
+ * ShadedVertex::inv_w for all three vertices, and linearly in screen space otherwise.
+ *
+ * @tparam VertexIn The vertex type handed to the vertex shader
+ * @param vertex_shader Callable mapping a VertexIn to a ShadedVertex in screen space
+ * @param fragment_shader Callable mapping a Fragment and the interpolated varying to an ARGB color
+ */
+template <typename VertexIn, typename Pixel, typename VS, typename FS>
+    requires VertexShader<VS, VertexIn> && FragmentShader<FS, std::remove_cvref_t<VertexShaderVarying<VS, VertexIn>>>
+auto Rasterizer::drawTriangle(const VertexIn &v1, const VertexIn &v2, const VertexIn &v3, BasicFrameBuffer<Pixel> &fb,
+                              VS &&vertex_shader, FS &&fragment_shader) -> void
+{
+    const auto a = vertex_shader(v1);
+    const auto b = vertex_shader(v2);
+    const auto c = vertex_shader(v3);
+    const Vector3<float> pa = a.position;
+    const Vector3<float> pb = b.position;
+    const Vector3<float> pc = c.position;
+
+    if (dirty_tracker_)
+    {
+        auto signature = beginSignature(DrawKind::Shaded);
+        signature.add(pa).add(pb).add(pc).add(a.inv_w).add(b.inv_w).add(c.inv_w);
+        addToSignature(signature, a.varying);
+        addToSignature(signature, b.varying);
+        addToSignature(signature, c.varying);
+        addToSignature(signature, fragment_shader);
+        dirty_tracker_->record(getTriangleBounds(pa, pb, pc), signature.getValue());
+        return;
+    }
+
+    TriangleSetup setup;
+    if (!setupTriangle(pa, pb, pc, setup))
+    {
+        return;
+    }
+
+    auto &color_buffer = fb.getBuffer();
+    auto &depth_buffer = fb.getDepthBuffer();
+    const uint32_t stride = fb.getWidth();
+
+    const DepthTest depth_test = depth_test_;
+
+    // Perspective correct interpolation weighs each vertex by its 1 / w and renormalizes per fragment
+    const bool perspective = a.inv_w > 0.0f && b.inv_w > 0.0f && c.inv_w > 0.0f;
+
+    QuadCoverage quad;
+    for (uint32_t y = setup.y_first; y <= setup.y_last; ++y)
+    {
+        for (uint32_t x = setup.x_first; x <= setup.x_last; x += kQuadWidth)
+        {
+            computeQuadCoverage(pa, pb, pc, setup, x, y, quad);
+            for (uint32_t lane = 0; lane < kQuadWidth; ++lane)
+            {
+                const size_t index = static_cast<size_t>(y) * stride + x + lane;
+                if (!quad.inside[lane])
+                {
+                    continue;
+                }
+                const float stored = depth_buffer[index];
+                const bool passed = depth_test == DepthTest::Less        ? quad.z[lane] < stored
+                                    : depth_test == DepthTest::LessEqual ? quad.z[lane] <= stored
+                                                                         : quad.z[lane] == stored;
+                if (!passed)
+                {
+                    continue;
+                }
+                if (depth_test != DepthTest::Equal)
+                {
+                    depth_buffer[index] = quad.z[lane];
+                }
+                float w0 = quad.w0[lane];
+                float w1 = quad.w1[lane];
+                float w2 = quad.w2[lane];
+                if (perspective)
+                {
+                    w0 *= a.inv_w;
+                    w1 *= b.inv_w;
+                    w2 *= c.inv_w;
+                    const float inv_sum = 1.0f / (w0 + w1 + w2);
+                    w0 *= inv_sum;
+                    w1 *= inv_sum;
+                    w2 *= inv_sum;
+                }
+                auto varying = a.varying * w0 + b.varying * w1 + c.varying * w2;
+                color_buffer[index] = Pixel::fromARGB(fragment_shader(Fragment{x + lane, y, quad.z[lane]}, varying));
+            }
+        }
+    }
+}
+
 } // namespace cam3d
 #endif // RASTERIZER_H
@@ -0,0 +1,147 @@
+/**
+ * @file shader.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <frame_buffer.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector3.hpp>
+
+namespace cam3d
+{
+
+/**
+ * @brief A varying is any value the rasterizer can blend between the three vertices of a triangle.
+ *
+ * Only scaling by a barycentric weight and summing is required, so plain structs with the two operators, or
+ * Vector3<float>, work out of the box.
+ */
+template <typename T>
+concept Varying = std::is_default_constructible_v<T> && requires(const T &a, const T &b, float w) {
+    { a * w } -> std::convertible_to<T>;
+    { a + b } -> std::convertible_to<T>;
+};
+
+/**
+ * @brief Empty varying for shaders that do not need interpolated data.
+ */
+struct NoVarying
+{
+    auto operator*(float) const -> NoVarying
+    {
+        return {};
+    }
+    auto operator+(const NoVarying &) const -> NoVarying
+    {
+        return {};
+    }
+};
+
+/**
+ * @brief Output of a vertex shader.
+ *
+ * @tparam V The varying type handed to the fragment shader.
+ * @note position is in screen space: x and y in pixels, z the depth in [0, 1].
+ * @note inv_w is the reciprocal of the clip space w, i.e. 1 / view depth for a perspective projection. When all three
+ * vertices of a triangle set it, varyings are interpolated perspective correct. Left at 0 they are interpolated
+ * linearly in screen space, which is exact for orthographic and already projected input.
+ */
+template <Varying V> struct ShadedVertex
+{
+    Vector3<float> position;
+    V varying;
+    float inv_w = 0.0f;
+};
+
+/**
+ * @brief Per pixel data handed to the fragment shader next to the interpolated varying.
+ */
+struct Fragment
+{
+    uint32_t x;
+    uint32_t y;
+    float depth;
+};
+
+template <typename VS, typename VertexIn>
+using VertexShaderVarying = decltype(std::declval<VS &>()(std::declval<const VertexIn &>()).varying);
+
+template <typename VS, typename VertexIn>
+concept VertexShader = requires(VS &vs, const VertexIn &in) {
+    { vs(in).position } -> std::convertible_to<Vector3<float>>;
+    requires Varying<std::remove_cvref_t<decltype(vs(in).varying)>>;
+};
+
+template <typename FS, typename V>
+concept FragmentShader = requires(FS &fs, const Fragment &frag, const V &v) {
+    { fs(frag, v) } -> std::convertible_to<ARGB>;
+};
+
+/// @note Built-in shaders
+/// ------------------------------------------------------------------------------  ///
+
+/**
+ * @brief Passes an already projected screen space position through without varyings.
+ */
+struct PassThroughVertexShader
+{
+    auto operator()(const Vector3<float> &v) const -> ShadedVertex<NoVarying>
+    {
+        return {v, {}};
+    }
+};
+
+/**
+ * @brief Shades every fragment with a single color, matching the flat drawTriangle overload.
+ */
+struct FlatFragmentShader
+{
+    ARGB color;
+
+    template <typename V> auto operator()(const Fragment &, const V &) const -> ARGB
+    {
+        return color;
+    }
+};
+
+/**
+ * @brief Visualizes depth as grayscale, near is white and far is black.
+ */
+struct DepthFragmentShader
+{
+    template <typename V> auto operator()(const Fragment &frag, const V &) const -> ARGB
+    {
+        auto value = static_cast<uint8_t>(255.0f * (1.0f - std::clamp(frag.depth, 0.0f, 1.0f)));
+        return ARGB(255, value, value, value);
+    }
+};
+
+/**
+ * @brief Interprets a Vector3<float> varying as an RGB color with components in [0, 1].
+ */
+struct ColorVaryingFragmentShader
+{
+    auto operator()(const Fragment &, const Vector3<float> &rgb) const -> ARGB
+    {
+        return ARGB(255, static_cast<uint8_t>(255.0f * std::clamp(rgb.x(), 0.0f, 1.0f)),
+                    static_cast<uint8_t>(255.0f * std::clamp(rgb.y(), 0.0f, 1.0f)),
+                    static_cast<uint8_t>(255.0f * std::clamp(rgb.z(), 0.0f, 1.0f)));
+    }
+};
+
+} // namespace cam3d
+
+#endif // SHADER_H
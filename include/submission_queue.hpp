@@ -0,0 +1,130 @@
+/**
+ * @file submission_queue.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SUBMISSION_QUEUE_H
+#define SUBMISSION_QUEUE_H
+
+#include <atomic>
+#include <command_buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cam3d
+{
+
+class SubmissionQueue;
+
+/**
+ * @brief A batch of draws published by one producer, recycled once the renderer has merged it
+ */
+struct SubmissionBatch
+{
+    CommandBuffer commands;
+    uint32_t layer = 0;
+    uint32_t producer = 0;
+    uint64_t sequence = 0;
+    SubmissionBatch *next = nullptr;
+    std::atomic<bool> in_flight{false};
+};
+
+/**
+ * @brief Per thread staging area of a SubmissionQueue
+ *
+ * Draws are recorded into a local CommandBuffer without any synchronization, submit() publishes it with a single
+ * compare and swap. A producer must only be used by one thread at a time.
+ */
+class SubmissionProducer
+{
+  public:
+    SubmissionProducer(const SubmissionProducer &) = delete;
+    auto operator=(const SubmissionProducer &) -> SubmissionProducer & = delete;
+
+    /**
+     * @brief The staging buffer the next submit() publishes, record draws into it
+     */
+    auto getCommandBuffer() -> CommandBuffer &;
+
+    /**
+     * @brief Publishes the staged draws to the queue, empty batches are skipped
+     */
+    auto submit() -> void;
+
+    auto getLayer() const -> uint32_t;
+
+  private:
+    friend class SubmissionQueue;
+
+    SubmissionProducer(SubmissionQueue &queue, uint32_t layer, uint32_t index);
+
+    auto acquireBatch() -> SubmissionBatch *;
+
+    SubmissionQueue &queue_;
+    uint32_t layer_;
+    uint32_t index_;
+    uint64_t sequence_;
+    SubmissionBatch *current_;
+    std::vector<std::unique_ptr<SubmissionBatch>> batches_;
+};
+
+/**
+ * @brief Lock free multi producer draw submission feeding a single renderer thread
+ *
+ * Producers push whole batches onto an intrusive stack, the renderer takes every pending batch with one exchange at
+ * the frame boundary. Merged batches are ordered by layer, then by producer creation order, then by submission order,
+ * so the frame is the same no matter how the producer threads were scheduled. Batches are recycled, recording does not
+ * allocate once the staging buffers have grown to their working size.
+ */
+class SubmissionQueue
+{
+  public:
+    SubmissionQueue();
+    ~SubmissionQueue() = default;
+
+    SubmissionQueue(const SubmissionQueue &) = delete;
+    auto operator=(const SubmissionQueue &) -> SubmissionQueue & = delete;
+
+    /**
+     * @brief Registers a producer drawing into the given layer, lower layers are replayed first
+     *
+     * Registration takes a lock and is meant for startup. Create producers that share a layer from one thread so
+     * their relative order is deterministic. The producer lives as long as the queue.
+     */
+    auto createProducer(uint32_t layer) -> SubmissionProducer &;
+
+    /**
+     * @brief Appends every batch submitted so far to frame in deterministic order and recycles the batches
+     *
+     * Must be called from one thread at a time. Batches submitted concurrently with the call go to the next frame.
+     *
+     * @return Number of batches merged
+     */
+    auto collect(CommandBuffer &frame) -> size_t;
+
+  private:
+    friend class SubmissionProducer;
+
+    auto push(SubmissionBatch *batch) -> void;
+
+    std::atomic<SubmissionBatch *> head_;
+
+    std::mutex producers_mutex_;
+    std::deque<std::unique_ptr<SubmissionProducer>> producers_;
+
+    std::vector<SubmissionBatch *> pending_;
+};
+
+} // namespace cam3d
+
+#endif // SUBMISSION_QUEUE_H
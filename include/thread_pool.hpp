@@ -0,0 +1,83 @@
+/**
+ * @file thread_pool.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-20
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cam3d
+{
+
+/**
+ * @brief Persistent worker threads for data parallel loops
+ *
+ * The calling thread takes part in every loop as worker 0, so a pool of N threads spawns N - 1 workers. Worker indices
+ * are stable and below getThreadCount(), which makes them usable as FrameArena sub arena indices. Loops must be issued
+ * from one thread at a time.
+ */
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+    auto getThreadCount() const -> size_t;
+
+    /**
+     * @brief Runs body(begin, end, worker_index) over chunks of [0, count) and returns once all chunks are done
+     *
+     * @param grain The smallest chunk handed to a worker, 0 picks one based on the thread count
+     */
+    template <typename F> auto parallelFor(size_t count, size_t grain, F &&body) -> void
+    {
+        using Body = std::remove_reference_t<F>;
+        dispatch(count, grain, [](void *context, size_t begin, size_t end, size_t worker) {
+            (*static_cast<Body *>(context))(begin, end, worker);
+        }, const_cast<void *>(static_cast<const void *>(&body)));
+    }
+
+  private:
+    using Invoke = void (*)(void *, size_t, size_t, size_t);
+
+    auto dispatch(size_t count, size_t grain, Invoke invoke, void *context) -> void;
+    auto work(size_t worker_index) -> void;
+    auto run(size_t worker_index) -> void;
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    uint64_t generation_;
+    size_t active_workers_;
+    bool stopping_;
+
+    Invoke invoke_;
+    void *context_;
+    size_t count_;
+    size_t chunk_size_;
+    std::atomic<size_t> next_chunk_;
+};
+
+} // namespace cam3d
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,110 @@
+/**
+ * @file transform.hpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-04-22
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <array>
+#include <cmath>
+#include <vector3.hpp>
+
+namespace cam3d
+{
+
+/**
+ * @brief Affine 3D transform stored as the upper 3x4 rows of a homogeneous matrix
+ */
+class Transform
+{
+  public:
+    using Matrix = std::array<std::array<float, 4>, 3>;
+
+    Transform() : m_{{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}}}
+    {
+    }
+    explicit Transform(const Matrix &m) : m_(m)
+    {
+    }
+    Transform(const std::array<std::array<float, 3>, 3> &rotation, const Vector3<float> &translation)
+        : m_{{{rotation[0][0], rotation[0][1], rotation[0][2], translation.x()},
+              {rotation[1][0], rotation[1][1], rotation[1][2], translation.y()},
+              {rotation[2][0], rotation[2][1], rotation[2][2], translation.z()}}}
+    {
+    }
+
+    static auto translation(const Vector3<float> &t) -> Transform
+    {
+        return Transform(Matrix{{{1, 0, 0, t.x()}, {0, 1, 0, t.y()}, {0, 0, 1, t.z()}}});
+    }
+
+    static auto scale(float s) -> Transform
+    {
+        return Transform(Matrix{{{s, 0, 0, 0}, {0, s, 0, 0}, {0, 0, s, 0}}});
+    }
+
+    /// @note Rotations take the angle in radians
+    static auto rotationX(float angle) -> Transform
+    {
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        return Transform(Matrix{{{1, 0, 0, 0}, {0, c, -s, 0}, {0, s, c, 0}}});
+    }
+
+    static auto rotationY(float angle) -> Transform
+    {
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        return Transform(Matrix{{{c, 0, s, 0}, {0, 1, 0, 0}, {-s, 0, c, 0}}});
+    }
+
+    static auto rotationZ(float angle) -> Transform
+    {
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        return Transform(Matrix{{{c, -s, 0, 0}, {s, c, 0, 0}, {0, 0, 1, 0}}});
+    }
+
+    auto apply(const Vector3<float> &v) const -> Vector3<float>
+    {
+        return Vector3<float>(m_[0][0] * v.x() + m_[0][1] * v.y() + m_[0][2] * v.z() + m_[0][3],
+                              m_[1][0] * v.x() + m_[1][1] * v.y() + m_[1][2] * v.z() + m_[1][3],
+                              m_[2][0] * v.x() + m_[2][1] * v.y() + m_[2][2] * v.z() + m_[2][3]);
+    }
+
+    /**
+     * @brief Composes two transforms, (a * b).apply(v) == a.apply(b.apply(v))
+     */
+    auto operator*(const Transform &other) const -> Transform
+    {
+        Matrix result{};
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                result[row][col] = m_[row][0] * other.m_[0][col] + m_[row][1] * other.m_[1][col] +
+                                   m_[row][2] * other.m_[2][col] + (col == 3 ? m_[row][3] : 0.0f);
+            }
+        }
+        return Transform(result);
+    }
+
+    auto getMatrix() const -> const Matrix &
+    {
+        return m_;
+    }
+
+  private:
+    Matrix m_;
+};
+
+} // namespace cam3d
+
+#endif // TRANSFORM_H
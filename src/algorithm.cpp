@@ -1,4 +1,5 @@
 #include <algorithm.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 
@@ -63,9 +64,11 @@ auto IntersectionCalculator::calculate2dLineIntersection(const Vector3<float> &l
 /// @note Bresenham algorithm
 /// ------------------------------------------------------------------------------  ///
 
-auto Bresenham::CalculateLine(float &x0, float &y0, float &x1, float &y1) -> std::vector<std::pair<uint32_t, uint32_t>>
+namespace
+{
+
+template <typename Points> auto bresenhamLine(float &x0, float &y0, float &x1, float &y1, Points &points) -> void
 {
-    std::vector<std::pair<uint32_t, uint32_t>> points;
     int dx = static_cast<int>(x1 - x0);
     int dy = static_cast<int>(y1 - y0);
 
@@ -74,6 +77,9 @@ auto Bresenham::CalculateLine(float &x0, float &y0, float &x1, float &y1) -> std
     dx = std::abs(dx);
     dy = std::abs(dy);
 
+    // Reserve once so arena backed storage does not leave discarded copies behind
+    points.reserve(points.size() + static_cast<size_t>(std::max(dx, dy)) + 1);
+
     // Cases
     // dx != 0 && dy != 0
     if (dx != 0 && dy != 0)
@@ -129,9 +135,22 @@ auto Bresenham::CalculateLine(float &x0, float &y0, float &x1, float &y1) -> std
             }
         }
     }
+}
+
+} // namespace
+
+auto Bresenham::CalculateLine(float &x0, float &y0, float &x1, float &y1) -> std::vector<std::pair<uint32_t, uint32_t>>
+{
+    std::vector<std::pair<uint32_t, uint32_t>> points;
+    bresenhamLine(x0, y0, x1, y1, points);
     return points;
 }
 
+auto Bresenham::CalculateLine(float &x0, float &y0, float &x1, float &y1, Points &points) -> void
+{
+    bresenhamLine(x0, y0, x1, y1, points);
+}
+
 /// @note Cohen–Sutherland clipping algorithm
 /// ------------------------------------------------------------------------------  ///
 
@@ -141,6 +160,12 @@ CohenSutherland::CohenSutherland(uint32_t width, uint32_t height)
     // Constructor
 }
 
+auto CohenSutherland::setBounds(uint32_t width, uint32_t height) -> void
+{
+    width_minus_1_ = width - 1;
+    height_minus_1_ = height - 1;
+}
+
 // Cohen–Sutherland clipping algorithm clips a line from
 // P0 = (x0, y0) to P1 = (x1, y1) against a rectangle with
 // diagonal from (0, 0) to (width, height)
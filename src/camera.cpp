@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <camera.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <pixel_format.hpp>
+
+namespace cam3d
+{
+
+/// @note Pinhole camera
+/// ------------------------------------------------------------------------------  ///
+
+PinholeCamera::PinholeCamera(const CameraIntrinsics &intrinsics, const BrownConradyDistortion &distortion,
+                             const Transform &world_to_camera, float near_plane, float far_plane)
+    : intrinsics_(intrinsics), distortion_(distortion), world_to_camera_(world_to_camera), near_plane_(near_plane),
+      far_plane_(far_plane), inv_depth_range_(1.0f / (far_plane - near_plane))
+{
+    assert(intrinsics.width > 0 && intrinsics.height > 0 && "Width and height must be greater than zero");
+    assert(intrinsics.fx > 0 && intrinsics.fy > 0 && "Focal lengths must be positive");
+    assert(near_plane > 0 && far_plane > near_plane && "Invalid clipping planes");
+}
+
+auto PinholeCamera::projectDistorted(const Vector3<float> &world) const -> Vector3<float>
+{
+    auto camera = world_to_camera_.apply(world);
+    float inv_z = 1.0f / camera.z();
+    auto [x, y] = distortion_.distort(camera.x() * inv_z, camera.y() * inv_z);
+    return Vector3<float>(intrinsics_.fx * x + intrinsics_.cx, intrinsics_.fy * y + intrinsics_.cy,
+                          (camera.z() - near_plane_) * inv_depth_range_);
+}
+
+auto PinholeCamera::setExtrinsics(const Transform &world_to_camera) -> void
+{
+    world_to_camera_ = world_to_camera;
+}
+
+auto PinholeCamera::getIntrinsics() const -> const CameraIntrinsics &
+{
+    return intrinsics_;
+}
+
+auto PinholeCamera::getDistortion() const -> const BrownConradyDistortion &
+{
+    return distortion_;
+}
+
+auto PinholeCamera::getExtrinsics() const -> const Transform &
+{
+    return world_to_camera_;
+}
+
+auto PinholeCamera::getNearPlane() const -> float
+{
+    return near_plane_;
+}
+
+auto PinholeCamera::getFarPlane() const -> float
+{
+    return far_plane_;
+}
+
+/// @note Distortion remap
+/// ------------------------------------------------------------------------------  ///
+
+DistortionRemap::DistortionRemap(const PinholeCamera &camera)
+    : width_(camera.getIntrinsics().width), height_(camera.getIntrinsics().height),
+      table_(static_cast<size_t>(width_) * height_)
+{
+    const auto &k = camera.getIntrinsics();
+    const auto &distortion = camera.getDistortion();
+    for (uint32_t v = 0; v < height_; ++v)
+    {
+        for (uint32_t u = 0; u < width_; ++u)
+        {
+            // Find where the ideal render has to be sampled for this distorted pixel
+            auto [x, y] = distortion.undistort((static_cast<float>(u) - k.cx) / k.fx,
+                                               (static_cast<float>(v) - k.cy) / k.fy);
+            float src_x = k.fx * x + k.cx;
+            float src_y = k.fy * y + k.cy;
+
+            auto &entry = table_[static_cast<size_t>(v) * width_ + u];
+            entry = Entry{0, 0, 0, 0, 0};
+            // Samples inside the area of a source pixel are valid, past the outer pixel centres they clamp to the edge
+            if (!(src_x >= -0.5f && src_y >= -0.5f && src_x < width_ - 0.5f && src_y < height_ - 0.5f))
+            {
+                continue;
+            }
+            src_x = std::clamp(src_x, 0.0f, static_cast<float>(width_ - 1));
+            src_y = std::clamp(src_y, 0.0f, static_cast<float>(height_ - 1));
+            auto x0 = static_cast<uint32_t>(src_x);
+            auto y0 = static_cast<uint32_t>(src_y);
+            entry.offset = y0 * width_ + x0;
+            entry.fx = static_cast<uint8_t>(std::min((src_x - x0) * 256.0f, 255.0f));
+            entry.fy = static_cast<uint8_t>(std::min((src_y - y0) * 256.0f, 255.0f));
+            entry.valid = 1;
+            // The last column and row have no right or bottom neighbour, their taps repeat the edge pixel
+            entry.steps = (x0 + 1 < width_ ? kRightTap : 0) | (y0 + 1 < height_ ? kBottomTap : 0);
+        }
+    }
+}
+
+auto DistortionRemap::apply(const FrameBuffer &undistorted, FrameBuffer &distorted) const -> void
+{
+    assert(undistorted.getWidth() == width_ && undistorted.getHeight() == height_ && "Source size mismatch");
+    assert(distorted.getWidth() == width_ && distorted.getHeight() == height_ && "Destination size mismatch");
+    static_assert(sizeof(ARGB) == sizeof(uint32_t), "ARGB must be packed into 32 bits");
+
+    const auto *src = undistorted.getBuffer().data();
+    auto *dst = distorted.getBuffer().data();
+    auto load = [src](uint32_t index) {
+        uint32_t value;
+        std::memcpy(&value, src + index, sizeof(value));
+        return value;
+    };
+
+    for (size_t i = 0; i < table_.size(); ++i)
+    {
+        const auto &entry = table_[i];
+        // Invalid entries have no steps, so all four taps read the same pixel before it is masked to transparent black
+        const uint32_t right = entry.steps & kRightTap;
+        const uint32_t bottom = entry.steps & kBottomTap ? width_ : 0;
+        const uint32_t blended = blendBilinear(load(entry.offset), load(entry.offset + right),
+                                               load(entry.offset + bottom), load(entry.offset + bottom + right),
+                                               entry.fx, entry.fy) &
+                                 (0u - entry.valid);
+        std::memcpy(static_cast<void *>(dst + i), &blended, sizeof(blended));
+    }
+}
+
+} // namespace cam3d
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <command_buffer.hpp>
+#include <cstring>
+#include <fstream>
+#include <shader.hpp>
+#include <tuple>
+
+namespace cam3d
+{
+
+namespace
+{
+
+constexpr char kFileMagic[8] = {'C', '3', 'D', 'C', 'M', 'D', '0', '1'};
+
+auto storeVertex(float (&dst)[3], const Vector3<float> &v) -> void
+{
+    dst[0] = v.x();
+    dst[1] = v.y();
+    dst[2] = v.z();
+}
+
+/// Rejects raw bytes that no record call can produce, a non finite depth would also break the ordering of sort()
+auto isValidCommand(const DrawCommand &command) -> bool
+{
+    const auto type = static_cast<uint8_t>(command.type);
+    const auto fill = static_cast<uint8_t>(command.fill);
+    if (type > static_cast<uint8_t>(CommandType::Triangle) || fill > static_cast<uint8_t>(FillMode::Depth) ||
+        command.opaque > 1)
+    {
+        return false;
+    }
+    for (const auto &vertex : command.vertices)
+    {
+        if (!std::isfinite(vertex[0]) || !std::isfinite(vertex[1]) || !std::isfinite(vertex[2]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+auto CommandBuffer::recordLine(const Vector3<float> &p_start, const Vector3<float> &p_end, const ARGB &color) -> void
+{
+    DrawCommand command{};
+    command.type = CommandType::Line;
+    command.fill = FillMode::Flat;
+    command.opaque = 0;
+    command.sequence = static_cast<uint32_t>(commands_.size());
+    command.color = color;
+    storeVertex(command.vertices[0], p_start);
+    storeVertex(command.vertices[1], p_end);
+    storeVertex(command.vertices[2], p_end);
+    commands_.push_back(command);
+}
+
+auto CommandBuffer::recordTriangle(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
+                                   const ARGB &color, FillMode fill, bool opaque) -> void
+{
+    DrawCommand command{};
+    command.type = CommandType::Triangle;
+    command.fill = fill;
+    command.opaque = opaque ? 1 : 0;
+    command.sequence = static_cast<uint32_t>(commands_.size());
+    command.color = color;
+    storeVertex(command.vertices[0], p1);
+    storeVertex(command.vertices[1], p2);
+    storeVertex(command.vertices[2], p3);
+    commands_.push_back(command);
+}
+
+auto CommandBuffer::sort() -> void
+{
+    auto nearest = [](const DrawCommand &command) {
+        return std::min({command.vertices[0][2], command.vertices[1][2], command.vertices[2][2]});
+    };
+    // The sequence number breaks every tie, so the order is deterministic
+    std::sort(commands_.begin(), commands_.end(), [&](const DrawCommand &a, const DrawCommand &b) {
+        if (a.opaque != b.opaque)
+        {
+            return a.opaque > b.opaque;
+        }
+        if (!a.opaque)
+        {
+            return a.sequence < b.sequence;
+        }
+        return std::make_tuple(a.getStateKey(), nearest(a), a.sequence) <
+               std::make_tuple(b.getStateKey(), nearest(b), b.sequence);
+    });
+}
+
+auto CommandBuffer::replay(const DrawCommand &command, Rasterizer &rasterizer, FrameBuffer &fb) -> void
+{
+    if (command.type == CommandType::Line)
+    {
+        rasterizer.drawLine(command.getVertex(0), command.getVertex(1), fb, command.color);
+    }
+    else if (command.fill == FillMode::Depth)
+    {
+        rasterizer.drawTriangle(command.getVertex(0), command.getVertex(1), command.getVertex(2), fb,
+                                PassThroughVertexShader{}, DepthFragmentShader{});
+    }
+    else
+    {
+        rasterizer.drawTriangle(command.getVertex(0), command.getVertex(1), command.getVertex(2), fb,
+                                PassThroughVertexShader{}, FlatFragmentShader{command.color});
+    }
+}
+
+auto CommandBuffer::execute(Rasterizer &rasterizer, FrameBuffer &fb) const -> void
+{
+    for (const auto &command : commands_)
+    {
+        replay(command, rasterizer, fb);
+    }
+}
+
+auto CommandBuffer::executeAfterPrepass(Rasterizer &rasterizer, FrameBuffer &fb) const -> void
+{
+    const DepthTest previous = rasterizer.getDepthTest();
+    for (const auto &command : commands_)
+    {
+        const bool prepassed = command.type == CommandType::Triangle && command.opaque;
+        rasterizer.setDepthTest(prepassed ? DepthTest::Equal : DepthTest::Less);
+        replay(command, rasterizer, fb);
+    }
+    rasterizer.setDepthTest(previous);
+}
+
+auto CommandBuffer::executeDepthOnly(Rasterizer &rasterizer, FrameBuffer &fb) const -> void
+{
+    for (const auto &command : commands_)
+    {
+        if (command.type == CommandType::Triangle && command.opaque)
+        {
+            rasterizer.drawTriangleDepth(command.getVertex(0), command.getVertex(1), command.getVertex(2), fb);
+        }
+    }
+}
+
+auto CommandBuffer::clear() -> void
+{
+    commands_.clear();
+}
+
+auto CommandBuffer::append(const CommandBuffer &other) -> void
+{
+    auto offset = static_cast<uint32_t>(commands_.size());
+    commands_.insert(commands_.end(), other.commands_.begin(), other.commands_.end());
+    for (auto it = commands_.begin() + offset; it != commands_.end(); ++it)
+    {
+        it->sequence += offset;
+    }
+}
+
+auto CommandBuffer::save(const std::string &path) const -> bool
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    uint64_t count = commands_.size();
+    file.write(kFileMagic, sizeof(kFileMagic));
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char *>(commands_.data()),
+               static_cast<std::streamsize>(count * sizeof(DrawCommand)));
+    return static_cast<bool>(file);
+}
+
+auto CommandBuffer::load(const std::string &path) -> bool
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    const auto file_size = static_cast<uint64_t>(std::max<std::streamoff>(file.tellg(), 0));
+    file.seekg(0);
+
+    char magic[sizeof(kFileMagic)];
+    uint64_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        count > (file_size - sizeof(kFileMagic) - sizeof(count)) / sizeof(DrawCommand))
+    {
+        return false;
+    }
+
+    std::vector<DrawCommand> commands(count);
+    file.read(reinterpret_cast<char *>(commands.data()), static_cast<std::streamsize>(count * sizeof(DrawCommand)));
+    if (!file || !std::all_of(commands.begin(), commands.end(), isValidCommand))
+    {
+        return false;
+    }
+    commands_ = std::move(commands);
+    return true;
+}
+
+auto CommandBuffer::getCommands() const -> const std::vector<DrawCommand> &
+{
+    return commands_;
+}
+
+auto CommandBuffer::size() const -> size_t
+{
+    return commands_.size();
+}
+
+} // namespace cam3d
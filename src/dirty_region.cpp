@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cassert>
+#include <dirty_region.hpp>
+
+namespace cam3d
+{
+
+DirtyRegionTracker::DirtyRegionTracker(uint32_t width, uint32_t height, uint32_t tile_size)
+    : width_(width), height_(height), tile_size_(tile_size), tiles_x_((width + tile_size - 1) / tile_size),
+      tiles_y_((height + tile_size - 1) / tile_size), invalidated_(true), dirty_tiles_(tiles_x_ * tiles_y_, 0)
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    assert(tile_size > 0 && "Tile size must be greater than zero");
+}
+
+auto DirtyRegionTracker::beginFrame() -> void
+{
+    std::swap(previous_draws_, current_draws_);
+    current_draws_.clear();
+}
+
+auto DirtyRegionTracker::record(const Rect &bounds, uint64_t signature) -> void
+{
+    current_draws_.push_back(DrawRecord{bounds, signature});
+}
+
+auto DirtyRegionTracker::invalidate() -> void
+{
+    invalidated_ = true;
+}
+
+auto DirtyRegionTracker::resize(uint32_t width, uint32_t height) -> void
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    width_ = width;
+    height_ = height;
+    tiles_x_ = (width + tile_size_ - 1) / tile_size_;
+    tiles_y_ = (height + tile_size_ - 1) / tile_size_;
+    dirty_tiles_.assign(tiles_x_ * tiles_y_, 0);
+    previous_draws_.clear();
+    invalidated_ = true;
+}
+
+auto DirtyRegionTracker::endFrame() -> const std::vector<Rect> &
+{
+    dirty_rects_.clear();
+
+    if (invalidated_)
+    {
+        invalidated_ = false;
+        dirty_rects_.push_back(Rect{0, 0, width_, height_});
+        return dirty_rects_;
+    }
+
+    std::fill(dirty_tiles_.begin(), dirty_tiles_.end(), 0);
+
+    // Draws are matched by submission order, anything unmatched on either side is dirty as well
+    size_t common = std::min(previous_draws_.size(), current_draws_.size());
+    for (size_t i = 0; i < common; ++i)
+    {
+        const auto &before = previous_draws_[i];
+        const auto &after = current_draws_[i];
+        if (before.signature != after.signature || before.bounds.x != after.bounds.x ||
+            before.bounds.y != after.bounds.y || before.bounds.width != after.bounds.width ||
+            before.bounds.height != after.bounds.height)
+        {
+            markDirty(before.bounds);
+            markDirty(after.bounds);
+        }
+    }
+    for (size_t i = common; i < previous_draws_.size(); ++i)
+    {
+        markDirty(previous_draws_[i].bounds);
+    }
+    for (size_t i = common; i < current_draws_.size(); ++i)
+    {
+        markDirty(current_draws_[i].bounds);
+    }
+
+    // Merge dirty tiles into horizontal runs, then grow each run downwards while the rows below match
+    for (uint32_t ty = 0; ty < tiles_y_; ++ty)
+    {
+        uint32_t tx = 0;
+        while (tx < tiles_x_)
+        {
+            if (!dirty_tiles_[ty * tiles_x_ + tx])
+            {
+                ++tx;
+                continue;
+            }
+            uint32_t run_end = tx;
+            while (run_end < tiles_x_ && dirty_tiles_[ty * tiles_x_ + run_end])
+            {
+                ++run_end;
+            }
+            uint32_t rows = 1;
+            while (ty + rows < tiles_y_)
+            {
+                auto row = dirty_tiles_.begin() + (ty + rows) * tiles_x_;
+                if (!std::all_of(row + tx, row + run_end, [](uint8_t tile) { return tile != 0; }) ||
+                    (tx > 0 && row[tx - 1]) || (run_end < tiles_x_ && row[run_end]))
+                {
+                    break;
+                }
+                std::fill(row + tx, row + run_end, 0);
+                ++rows;
+            }
+
+            uint32_t x = tx * tile_size_;
+            uint32_t y = ty * tile_size_;
+            dirty_rects_.push_back(Rect{x, y, std::min(run_end * tile_size_, width_) - x,
+                                        std::min((ty + rows) * tile_size_, height_) - y});
+            tx = run_end;
+        }
+    }
+    return dirty_rects_;
+}
+
+auto DirtyRegionTracker::markDirty(const Rect &rect) -> void
+{
+    if (rect.isEmpty())
+    {
+        return;
+    }
+    uint32_t tx_first = std::min(rect.x / tile_size_, tiles_x_ - 1);
+    uint32_t ty_first = std::min(rect.y / tile_size_, tiles_y_ - 1);
+    uint32_t tx_last = std::min((rect.x + rect.width - 1) / tile_size_, tiles_x_ - 1);
+    uint32_t ty_last = std::min((rect.y + rect.height - 1) / tile_size_, tiles_y_ - 1);
+    for (uint32_t ty = ty_first; ty <= ty_last; ++ty)
+    {
+        std::fill(dirty_tiles_.begin() + ty * tiles_x_ + tx_first, dirty_tiles_.begin() + ty * tiles_x_ + tx_last + 1,
+                  1);
+    }
+}
+
+} // namespace cam3d
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <dynamic_resolution.hpp>
+#include <pixel_format.hpp>
+#include <utility>
+
+namespace cam3d
+{
+
+namespace
+{
+
+constexpr float kSmoothing = 0.1f;   // Weight of the newest sample in the moving average
+constexpr float kUpperBand = 1.05f;  // Shrink once the average is this far over budget
+constexpr float kLowerBand = 0.8f;   // Grow once the average is this far under budget
+constexpr float kHeadroom = 0.9f;    // Aim a bit under budget so a resize does not land right on the edge
+constexpr float kMaxShrink = 0.75f;  // Largest change of the scale per resize, shrinking reacts faster than growing
+constexpr float kMaxGrow = 1.1f;
+constexpr uint32_t kSizeAlignment = 8;
+
+auto alignedSize(uint32_t output, float scale) -> uint32_t
+{
+    auto size = static_cast<uint32_t>(std::lround(output * scale / kSizeAlignment)) * kSizeAlignment;
+    return std::clamp(size, std::min(kSizeAlignment, output), output);
+}
+
+/// Maps a destination pixel center into the source, returns the left tap and the right tap weight in 1/256
+auto sourceTap(uint32_t dst, uint32_t src_size, uint32_t dst_size) -> std::pair<uint32_t, uint32_t>
+{
+    float position = (dst + 0.5f) * src_size / dst_size - 0.5f;
+    position = std::clamp(position, 0.0f, static_cast<float>(src_size - 1));
+    auto first = static_cast<uint32_t>(position);
+    auto weight = static_cast<uint32_t>((position - first) * 256.0f);
+    return {first, std::min(weight, 255u)};
+}
+
+} // namespace
+
+DynamicResolution::DynamicResolution(uint32_t output_width, uint32_t output_height, float target_ms, float min_scale)
+    : output_width_(output_width), output_height_(output_height), target_ms_(target_ms), min_scale_(min_scale),
+      scale_(1.0f), average_ms_(-1.0f), render_width_(output_width), render_height_(output_height),
+      columns_src_width_(0), columns_dst_width_(0)
+{
+    assert(output_width > 0 && output_height > 0 && "Width and height must be greater than zero");
+    assert(target_ms > 0 && "Target time must be greater than zero");
+    assert(min_scale > 0 && min_scale <= 1 && "Minimum scale must be in (0, 1]");
+}
+
+auto DynamicResolution::update(float raster_ms) -> bool
+{
+    if (average_ms_ < 0)
+    {
+        average_ms_ = raster_ms;
+    }
+    else
+    {
+        average_ms_ += kSmoothing * (raster_ms - average_ms_);
+    }
+
+    bool over_budget = average_ms_ > target_ms_ * kUpperBand;
+    bool under_budget = average_ms_ < target_ms_ * kLowerBand && scale_ < 1.0f;
+    if (!over_budget && !under_budget)
+    {
+        return false;
+    }
+
+    float ratio = std::sqrt(target_ms_ * kHeadroom / std::max(average_ms_, 1e-3f));
+    float scale = std::clamp(scale_ * std::clamp(ratio, kMaxShrink, kMaxGrow), min_scale_, 1.0f);
+
+    const auto previous_pixels = static_cast<float>(render_width_) * render_height_;
+    if (!applyScale(scale))
+    {
+        return false;
+    }
+    // Predict the cost at the new size so the average does not trigger another resize while it catches up
+    average_ms_ *= static_cast<float>(render_width_) * render_height_ / previous_pixels;
+    return true;
+}
+
+auto DynamicResolution::applyScale(float scale) -> bool
+{
+    scale_ = scale;
+    uint32_t width = alignedSize(output_width_, scale);
+    uint32_t height = alignedSize(output_height_, scale);
+    if (width == render_width_ && height == render_height_)
+    {
+        return false;
+    }
+    render_width_ = width;
+    render_height_ = height;
+    return true;
+}
+
+auto DynamicResolution::buildColumns(uint32_t src_width, uint32_t dst_width) -> void
+{
+    columns_.resize(dst_width);
+    for (uint32_t x = 0; x < dst_width; ++x)
+    {
+        auto [first, weight] = sourceTap(x, src_width, dst_width);
+        columns_[x] = Tap{first, first + 1 < src_width ? 1u : 0u, weight};
+    }
+    columns_src_width_ = src_width;
+    columns_dst_width_ = dst_width;
+}
+
+auto DynamicResolution::upscale(const FrameBuffer &src, FrameBuffer &dst) -> void
+{
+    static_assert(sizeof(ARGB) == sizeof(uint32_t), "ARGB must be packed into 32 bits");
+    const uint32_t src_width = src.getWidth();
+    const uint32_t src_height = src.getHeight();
+    const uint32_t dst_width = dst.getWidth();
+    const uint32_t dst_height = dst.getHeight();
+
+    if (src_width == dst_width && src_height == dst_height)
+    {
+        std::memcpy(static_cast<void *>(dst.getBuffer().data()), src.getBuffer().data(),
+                    static_cast<size_t>(dst_width) * dst_height * sizeof(ARGB));
+        return;
+    }
+    if (columns_src_width_ != src_width || columns_dst_width_ != dst_width)
+    {
+        buildColumns(src_width, dst_width);
+    }
+
+    const auto *pixels = src.getBuffer().data();
+    auto load = [pixels](size_t index) {
+        uint32_t value;
+        std::memcpy(&value, pixels + index, sizeof(value));
+        return value;
+    };
+
+    for (uint32_t y = 0; y < dst_height; ++y)
+    {
+        auto [row, fy] = sourceTap(y, src_height, dst_height);
+        const size_t top = static_cast<size_t>(row) * src_width;
+        const size_t bottom = row + 1 < src_height ? top + src_width : top;
+        auto *out = dst.getBuffer().data() + static_cast<size_t>(y) * dst_width;
+
+        for (uint32_t x = 0; x < dst_width; ++x)
+        {
+            const auto &tap = columns_[x];
+            const uint32_t blended =
+                blendBilinear(load(top + tap.offset), load(top + tap.offset + tap.step), load(bottom + tap.offset),
+                              load(bottom + tap.offset + tap.step), tap.weight, fy);
+            std::memcpy(static_cast<void *>(out + x), &blended, sizeof(blended));
+        }
+    }
+}
+
+auto DynamicResolution::setTargetTime(float target_ms) -> void
+{
+    assert(target_ms > 0 && "Target time must be greater than zero");
+    target_ms_ = target_ms;
+}
+
+auto DynamicResolution::getRenderWidth() const -> uint32_t
+{
+    return render_width_;
+}
+
+auto DynamicResolution::getRenderHeight() const -> uint32_t
+{
+    return render_height_;
+}
+
+auto DynamicResolution::getScale() const -> float
+{
+    return scale_;
+}
+
+auto DynamicResolution::getAverageTime() const -> float
+{
+    return average_ms_;
+}
+
+} // namespace cam3d
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <frame_arena.hpp>
+
+namespace cam3d
+{
+
+/// @note Linear arena
+/// ------------------------------------------------------------------------------  ///
+
+LinearArena::LinearArena(size_t block_size)
+    : block_size_(block_size), current_block_(0), offset_(0), block_allocation_count_(0)
+{
+    assert(block_size > 0 && "Block size must be greater than zero");
+}
+
+auto LinearArena::allocate(size_t bytes, size_t alignment) -> void *
+{
+    while (current_block_ < blocks_.size())
+    {
+        auto &block = blocks_[current_block_];
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t aligned = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + bytes <= block.size)
+        {
+            offset_ = aligned + bytes;
+            return block.data.get() + aligned;
+        }
+        // Move on to the next retained block
+        ++current_block_;
+        offset_ = 0;
+    }
+
+    // Every retained block is full, grow the arena. This only happens until the arena has seen its largest frame.
+    size_t size = std::max(block_size_, bytes + alignment);
+    blocks_.push_back(Block{std::make_unique<std::byte[]>(size), size});
+    ++block_allocation_count_;
+    current_block_ = blocks_.size() - 1;
+    offset_ = 0;
+    return allocate(bytes, alignment);
+}
+
+auto LinearArena::deallocate(void *ptr, size_t bytes) -> void
+{
+    if (current_block_ >= blocks_.size())
+    {
+        return;
+    }
+    // Only the most recent allocation can be handed back
+    auto *base = blocks_[current_block_].data.get();
+    if (bytes <= offset_ && static_cast<std::byte *>(ptr) == base + offset_ - bytes)
+    {
+        offset_ -= bytes;
+    }
+}
+
+auto LinearArena::reset() -> void
+{
+    current_block_ = 0;
+    offset_ = 0;
+}
+
+auto LinearArena::mark() const -> Marker
+{
+    return Marker{current_block_, offset_};
+}
+
+auto LinearArena::rewind(const Marker &marker) -> void
+{
+    current_block_ = marker.block;
+    offset_ = marker.offset;
+}
+
+auto LinearArena::getBlockAllocationCount() const -> size_t
+{
+    return block_allocation_count_;
+}
+
+/// @note Frame arena
+/// ------------------------------------------------------------------------------  ///
+
+FrameArena::FrameArena(size_t thread_count, size_t block_size) : block_size_(block_size)
+{
+    setThreadCount(thread_count);
+}
+
+auto FrameArena::reset() -> void
+{
+    for (auto &arena : arenas_)
+    {
+        arena->reset();
+    }
+}
+
+auto FrameArena::setThreadCount(size_t thread_count) -> void
+{
+    assert(thread_count > 0 && "Thread count must be greater than zero");
+    arenas_.reserve(thread_count);
+    while (arenas_.size() < thread_count)
+    {
+        arenas_.push_back(std::make_unique<LinearArena>(block_size_));
+    }
+    arenas_.resize(thread_count);
+}
+
+auto FrameArena::getThreadCount() const -> size_t
+{
+    return arenas_.size();
+}
+
+auto FrameArena::getBlockAllocationCount() const -> size_t
+{
+    size_t count = 0;
+    for (const auto &arena : arenas_)
+    {
+        count += arena->getBlockAllocationCount();
+    }
+    return count;
+}
+
+} // namespace cam3d
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <frame_capture.hpp>
+#include <iostream>
+#include <pixel_format.hpp>
+
+namespace cam3d
+{
+
+namespace
+{
+
+auto sequencePath(const std::string &directory, const char *prefix, uint64_t index, const char *extension)
+    -> std::filesystem::path
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s_%06llu.%s", prefix, static_cast<unsigned long long>(index), extension);
+    return std::filesystem::path(directory) / name;
+}
+
+} // namespace
+
+FrameCapture::FrameCapture(uint32_t width, uint32_t height, CaptureSettings settings)
+    : width_(width), height_(height), settings_(std::move(settings)), in_flight_(0), next_index_(0),
+      stopping_(false), written_count_(0), dropped_count_(0), error_(false)
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    assert(settings_.queue_depth > 0 && "Queue depth must be greater than zero");
+
+    // Every buffer is allocated up front and recycled, capturing never allocates per frame
+    size_t pixel_count = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < settings_.queue_depth; ++i)
+    {
+        auto frame = std::make_unique<CaptureFrame>();
+        frame->color.resize(pixel_count);
+        if (settings_.export_depth)
+        {
+            frame->depth.resize(pixel_count);
+        }
+        free_frames_.push_back(frame.get());
+        frames_.push_back(std::move(frame));
+    }
+
+    // Large enough for three 8-bit planes or one 16-bit depth plane
+    scratch_.resize(pixel_count * 3);
+
+    if (settings_.format == CaptureFormat::Y4mVideo)
+    {
+        video_.open(settings_.output_path, std::ios::binary | std::ios::trunc);
+        video_ << "YUV4MPEG2 W" << width_ << " H" << height_ << " F" << settings_.frame_rate << ":1 Ip A1:1 C444\n";
+        if (!video_)
+        {
+            std::cerr << "FrameCapture: cannot open " << settings_.output_path << std::endl;
+            error_ = true;
+        }
+    }
+    else
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(settings_.output_path, ec);
+    }
+
+    writer_ = std::thread(&FrameCapture::run, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    frame_pending_.notify_one();
+    writer_.join();
+}
+
+template <typename Pixel> auto FrameCapture::submit(const BasicFrameBuffer<Pixel> &fb) -> bool
+{
+    assert(fb.getWidth() == width_ && fb.getHeight() == height_ && "Frame buffer size does not match the capture");
+
+    CaptureFrame *frame = acquireFrame();
+    if (!frame)
+    {
+        return false;
+    }
+
+    // Convert outside the lock, the writer never touches a frame that is not pending
+    convertToARGB8888(fb.getBuffer().data(), frame->color.data(), frame->color.size());
+    if (settings_.export_depth)
+    {
+        const auto &depth = fb.getDepthBuffer();
+        std::copy(depth.begin(), depth.begin() + frame->depth.size(), frame->depth.begin());
+    }
+
+    queueFrame(frame);
+    return true;
+}
+
+template auto FrameCapture::submit(const BasicFrameBuffer<ARGB> &fb) -> bool;
+template auto FrameCapture::submit(const BasicFrameBuffer<RGB565> &fb) -> bool;
+template auto FrameCapture::submit(const BasicFrameBuffer<Gray8> &fb) -> bool;
+
+auto FrameCapture::acquireFrame() -> CaptureFrame *
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_frames_.empty())
+    {
+        if (settings_.overflow == CaptureOverflow::Drop)
+        {
+            ++dropped_count_;
+            return nullptr;
+        }
+        frame_freed_.wait(lock, [this] { return !free_frames_.empty(); });
+    }
+    auto *frame = free_frames_.back();
+    free_frames_.pop_back();
+    frame->index = next_index_++;
+    return frame;
+}
+
+auto FrameCapture::queueFrame(CaptureFrame *frame) -> void
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_frames_.push_back(frame);
+        ++in_flight_;
+    }
+    frame_pending_.notify_one();
+}
+
+auto FrameCapture::flush() -> void
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    frame_freed_.wait(lock, [this] { return in_flight_ == 0; });
+    if (video_.is_open())
+    {
+        video_.flush();
+    }
+}
+
+auto FrameCapture::getWrittenFrameCount() const -> uint64_t
+{
+    return written_count_;
+}
+
+auto FrameCapture::getDroppedFrameCount() const -> uint64_t
+{
+    return dropped_count_;
+}
+
+auto FrameCapture::hasError() const -> bool
+{
+    return error_;
+}
+
+auto FrameCapture::run() -> void
+{
+    while (true)
+    {
+        CaptureFrame *frame = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            frame_pending_.wait(lock, [this] { return stopping_ || !pending_frames_.empty(); });
+            if (pending_frames_.empty())
+            {
+                return; // Stopping and drained
+            }
+            frame = pending_frames_.front();
+            pending_frames_.pop_front();
+        }
+
+        if (!error_ && writeFrame(*frame))
+        {
+            ++written_count_;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_frames_.push_back(frame);
+            --in_flight_;
+        }
+        frame_freed_.notify_all();
+    }
+}
+
+auto FrameCapture::writeFrame(const CaptureFrame &frame) -> bool
+{
+    bool ok = settings_.format == CaptureFormat::Y4mVideo ? writeY4m(frame) : writePpm(frame);
+    if (ok && settings_.export_depth)
+    {
+        ok = writeDepthPgm(frame);
+    }
+    if (!ok)
+    {
+        std::cerr << "FrameCapture: failed to write frame " << frame.index << std::endl;
+        error_ = true;
+    }
+    return ok;
+}
+
+auto FrameCapture::writePpm(const CaptureFrame &frame) -> bool
+{
+    for (size_t i = 0; i < frame.color.size(); ++i)
+    {
+        scratch_[i * 3 + 0] = static_cast<uint8_t>(frame.color[i] >> 16);
+        scratch_[i * 3 + 1] = static_cast<uint8_t>(frame.color[i] >> 8);
+        scratch_[i * 3 + 2] = static_cast<uint8_t>(frame.color[i]);
+    }
+
+    std::ofstream file(sequencePath(settings_.output_path, "frame", frame.index, "ppm"),
+                       std::ios::binary | std::ios::trunc);
+    file << "P6\n" << width_ << " " << height_ << "\n255\n";
+    file.write(reinterpret_cast<const char *>(scratch_.data()), static_cast<std::streamsize>(scratch_.size()));
+    return static_cast<bool>(file);
+}
+
+auto FrameCapture::writeY4m(const CaptureFrame &frame) -> bool
+{
+    // BT.601 studio range, planar Y, U and V
+    size_t pixel_count = frame.color.size();
+    uint8_t *y_plane = scratch_.data();
+    uint8_t *u_plane = y_plane + pixel_count;
+    uint8_t *v_plane = u_plane + pixel_count;
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        int r = (frame.color[i] >> 16) & 0xff;
+        int g = (frame.color[i] >> 8) & 0xff;
+        int b = frame.color[i] & 0xff;
+        y_plane[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        u_plane[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        v_plane[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    video_ << "FRAME\n";
+    video_.write(reinterpret_cast<const char *>(scratch_.data()), static_cast<std::streamsize>(scratch_.size()));
+    return static_cast<bool>(video_);
+}
+
+auto FrameCapture::writeDepthPgm(const CaptureFrame &frame) -> bool
+{
+    // Depth in [0, 1] maps to the full 16-bit range, cleared pixels saturate to 65535. PGM stores big endian.
+    auto *depth_bytes = scratch_.data();
+    for (size_t i = 0; i < frame.depth.size(); ++i)
+    {
+        auto value = static_cast<uint16_t>(std::clamp(frame.depth[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+        depth_bytes[i * 2 + 0] = static_cast<uint8_t>(value >> 8);
+        depth_bytes[i * 2 + 1] = static_cast<uint8_t>(value & 0xff);
+    }
+
+    auto directory = settings_.format == CaptureFormat::Y4mVideo
+                         ? std::filesystem::path(settings_.output_path).parent_path().string()
+                         : settings_.output_path;
+    std::ofstream file(sequencePath(directory, "depth", frame.index, "pgm"), std::ios::binary | std::ios::trunc);
+    file << "P5\n" << width_ << " " << height_ << "\n65535\n";
+    file.write(reinterpret_cast<const char *>(depth_bytes), static_cast<std::streamsize>(frame.depth.size() * 2));
+    return static_cast<bool>(file);
+}
+
+} // namespace cam3d
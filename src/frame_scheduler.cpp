@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <frame_scheduler.hpp>
+#include <thread>
+
+namespace cam3d
+{
+
+namespace
+{
+
+// Bounds of the spin margin, sleeping is trusted for all but the last part of the wait
+constexpr auto kMinSpinMargin = std::chrono::microseconds(100);
+constexpr auto kMaxSpinMargin = std::chrono::milliseconds(4);
+constexpr auto kInitialSpinMargin = std::chrono::milliseconds(1);
+
+auto toMilliseconds(FrameScheduler::Clock::duration duration) -> float
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+} // namespace
+
+/// @note FrameTimeHistogram
+/// ------------------------------------------------------------------------------  ///
+
+FrameTimeHistogram::FrameTimeHistogram(size_t window_size)
+    : buckets_(kBucketCount, 0), window_(window_size, 0), next_(0), count_(0)
+{
+    assert(window_size > 0 && "Window size must be greater than zero");
+    static_assert(kBucketCount <= UINT16_MAX, "Bucket indices are stored in 16 bits");
+}
+
+auto FrameTimeHistogram::bucketOf(float milliseconds) -> size_t
+{
+    if (!(milliseconds > 0))
+    {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(milliseconds / kBucketWidthMs), kBucketCount - 1);
+}
+
+auto FrameTimeHistogram::add(float milliseconds) -> void
+{
+    if (count_ == window_.size())
+    {
+        --buckets_[window_[next_]];
+    }
+    else
+    {
+        ++count_;
+    }
+    const auto bucket = bucketOf(milliseconds);
+    window_[next_] = static_cast<uint16_t>(bucket);
+    ++buckets_[bucket];
+    next_ = (next_ + 1) % window_.size();
+}
+
+auto FrameTimeHistogram::getPercentile(float fraction) const -> float
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    const auto rank =
+        std::max<size_t>(1, static_cast<size_t>(std::ceil(std::clamp(fraction, 0.0f, 1.0f) * count_)));
+    size_t seen = 0;
+    for (size_t bucket = 0; bucket < kBucketCount; ++bucket)
+    {
+        seen += buckets_[bucket];
+        if (seen >= rank)
+        {
+            return static_cast<float>(bucket + 1) * kBucketWidthMs;
+        }
+    }
+    return kBucketCount * kBucketWidthMs;
+}
+
+auto FrameTimeHistogram::getBuckets() const -> const std::vector<uint32_t> &
+{
+    return buckets_;
+}
+
+auto FrameTimeHistogram::getSampleCount() const -> size_t
+{
+    return count_;
+}
+
+auto FrameTimeHistogram::clear() -> void
+{
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    next_ = 0;
+    count_ = 0;
+}
+
+/// @note FrameScheduler
+/// ------------------------------------------------------------------------------  ///
+
+FrameScheduler::FrameScheduler(float target_rate, size_t window_size)
+    : uncapped_(false), started_(false), spin_margin_(kInitialSpinMargin), work_ms_(0), histogram_(window_size)
+{
+    setTargetRate(target_rate);
+}
+
+auto FrameScheduler::beginFrame() -> void
+{
+    work_start_ = Clock::now();
+    if (!started_)
+    {
+        started_ = true;
+        last_frame_end_ = work_start_;
+        deadline_ = work_start_ + period_;
+    }
+}
+
+auto FrameScheduler::endFrame() -> void
+{
+    assert(started_ && "beginFrame must be called first");
+    auto now = Clock::now();
+    work_ms_ = toMilliseconds(now - work_start_);
+
+    if (!uncapped_)
+    {
+        waitUntil(deadline_);
+        now = Clock::now();
+    }
+
+    histogram_.add(toMilliseconds(now - last_frame_end_));
+    last_frame_end_ = now;
+
+    deadline_ += period_;
+    if (deadline_ < now)
+    {
+        // Missed the deadline, restart the schedule from here instead of bursting frames to catch up
+        deadline_ = now + period_;
+    }
+}
+
+auto FrameScheduler::waitUntil(Clock::time_point deadline) -> void
+{
+    const auto wake = deadline - spin_margin_;
+    if (wake > Clock::now())
+    {
+        std::this_thread::sleep_until(wake);
+        // Keep the margin around twice the typical wake up latency
+        const auto late = Clock::now() - wake;
+        spin_margin_ += (2 * late - spin_margin_) / 8;
+        spin_margin_ = std::clamp<Clock::duration>(spin_margin_, kMinSpinMargin, kMaxSpinMargin);
+    }
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+auto FrameScheduler::setTargetRate(float frames_per_second) -> void
+{
+    assert(frames_per_second > 0 && "Target rate must be greater than zero");
+    period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frames_per_second));
+    deadline_ = last_frame_end_ + period_;
+}
+
+auto FrameScheduler::setUncapped(bool uncapped) -> void
+{
+    uncapped_ = uncapped;
+}
+
+auto FrameScheduler::isUncapped() const -> bool
+{
+    return uncapped_;
+}
+
+auto FrameScheduler::getStats() const -> FrameStats
+{
+    return FrameStats{histogram_.getPercentile(0.50f), histogram_.getPercentile(0.95f),
+                      histogram_.getPercentile(0.99f), work_ms_, histogram_.getSampleCount()};
+}
+
+auto FrameScheduler::getHistogram() const -> const FrameTimeHistogram &
+{
+    return histogram_;
+}
+
+auto FrameScheduler::getTargetRate() const -> float
+{
+    return static_cast<float>(1.0 / std::chrono::duration<double>(period_).count());
+}
+
+} // namespace cam3d
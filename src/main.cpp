@@ -9,23 +9,46 @@
  *
  */
 
+#include <cstdio>
 #include <cstdlib>
 #include <rasterizer.hpp>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_render.h>
 #include <chrono>
+#include <dirty_region.hpp>
+#include <dynamic_resolution.hpp>
 #include <frame_buffer.hpp>
+#include <frame_capture.hpp>
+#include <frame_scheduler.hpp>
 #include <memory>
 #include <random>
+#include <shader.hpp>
+#include <string>
 #include <vector3.hpp>
 
 int main(int argc, char *argv[])
 {
 
-    if (argc > 1)
+    // Optionally stream every frame to a PPM sequence, e.g. cam3d_example --capture frames/
+    // --uncapped renders as fast as possible instead of pacing to 60 FPS
+    std::string capture_path;
+    bool uncapped = false;
+    for (int i = 1; i < argc; ++i)
     {
-        SDL_Log("Usage: %s", argv[0]);
+        std::string arg = argv[i];
+        if (arg == "--capture" && i + 1 < argc)
+        {
+            capture_path = argv[++i];
+        }
+        else if (arg == "--uncapped")
+        {
+            uncapped = true;
+        }
+        else
+        {
+            SDL_Log("Usage: %s [--capture <directory>] [--uncapped]", argv[0]);
+        }
     }
 
     if (!SDL_Init(SDL_INIT_VIDEO))
@@ -58,9 +81,18 @@ int main(int argc, char *argv[])
     // Create a frame buffer
     auto frameBuffer = std::make_unique<cam3d::FrameBuffer>(width, height);
     auto rasterizer = std::make_unique<cam3d::Rasterizer>(width, height);
-    // SDL Texture
+    auto dirtyTracker = std::make_unique<cam3d::DirtyRegionTracker>(width, height);
+    // The scene is rendered at a resolution that tracks the raster budget and upscaled into the present buffer
+    auto dynamicResolution = std::make_unique<cam3d::DynamicResolution>(width, height, 8.0f);
+    auto presentBuffer = std::make_unique<cam3d::FrameBuffer>(width, height);
+    std::unique_ptr<cam3d::FrameCapture> frameCapture;
+    if (!capture_path.empty())
+    {
+        frameCapture = std::make_unique<cam3d::FrameCapture>(width, height, cam3d::CaptureSettings{capture_path});
+    }
+    // SDL Texture, ARGB32 is the byte order cam3d::ARGB has in memory (a, r, g, b) on every platform
     SDL_Texture *texture =
-        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB32, SDL_TEXTUREACCESS_STREAMING, width, height);
 
     // generate random color
     std::random_device rd;
@@ -89,16 +121,25 @@ int main(int argc, char *argv[])
         cam3d::Vector3<float>(1.0f, -0.5f, 0.9f) // Vertex 3
     };
 
+    // The view depth is the perspective w, passing its reciprocal makes the color interpolation perspective correct
+    auto vertex_shader = [&rasterizer](const cam3d::Vector3<float> &v) {
+        return cam3d::ShadedVertex<cam3d::Vector3<float>>{
+            rasterizer->projectBasicPerspective(v), cam3d::Vector3<float>((v.x() + 1) / 2, (v.y() + 1) / 2, v.z()),
+            1.0f / v.z()};
+    };
+
     cam3d::Vector3<float> start(-50.0f, 120.0f, 0.0f);
     cam3d::Vector3<float> end(900.0f, 200.0f, 0.0f);
 
     bool running = true;
     SDL_Event event;
-    std::chrono::high_resolution_clock::time_point tp;
+    cam3d::FrameScheduler scheduler(60.0f);
+    scheduler.setUncapped(uncapped);
+    char overlay_text[128];
 
-    tp = std::chrono::high_resolution_clock::now();
     while (running)
     {
+        scheduler.beginFrame();
         while (SDL_PollEvent(&event))
         {
             if (event.type == SDL_EVENT_QUIT)
@@ -110,17 +151,75 @@ int main(int argc, char *argv[])
         SDL_RenderClear(renderer);
 
 
-        frameBuffer->clear(color);
+        auto raster_start = std::chrono::steady_clock::now();
+        const bool native_resolution = frameBuffer->getWidth() == width && frameBuffer->getHeight() == height;
+        rasterizer->beginFrame();
+
+        // Draw triangle with perspective projection, colored by its view space position
+        auto draw_scene = [&]() {
+            rasterizer->drawTriangle(test_triangle[0], test_triangle[1], test_triangle[2], *frameBuffer, vertex_shader,
+                                     cam3d::ColorVaryingFragmentShader{});
+        };
+
+        // The first pass only records the bounds of every draw, regions that changed since the last frame are redrawn
+        dirtyTracker->beginFrame();
+        rasterizer->setDirtyRegionTracker(dirtyTracker.get());
+        draw_scene();
+        rasterizer->setDirtyRegionTracker(nullptr);
+
+        const auto &dirty_rects = dirtyTracker->endFrame();
+        for (const auto &rect : dirty_rects)
+        {
+            rasterizer->setScissor(rect);
+            frameBuffer->clear(rect, color);
+            draw_scene();
+
+            if (native_resolution)
+            {
+                SDL_Rect texture_rect{static_cast<int>(rect.x), static_cast<int>(rect.y),
+                                      static_cast<int>(rect.width), static_cast<int>(rect.height)};
+                SDL_UpdateTexture(texture, &texture_rect, frameBuffer->getBuffer().data() + rect.y * width + rect.x,
+                                  width * sizeof(cam3d::ARGB));
+            }
+        }
+        rasterizer->resetScissor();
+        auto raster_ms =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - raster_start).count();
+
+        // The present buffer still holds the last upscale when nothing changed, a resize always dirties everything
+        const auto *output = native_resolution ? frameBuffer.get() : presentBuffer.get();
+        if (!native_resolution && !dirty_rects.empty())
+        {
+            dynamicResolution->upscale(*frameBuffer, *presentBuffer);
+            SDL_UpdateTexture(texture, NULL, presentBuffer->getBuffer().data(), width * sizeof(cam3d::ARGB));
+        }
+
+        if (frameCapture)
+        {
+            frameCapture->submit(*output);
+        }
 
-        // // Draw triangle with perspective projection
-        rasterizer->drawTriangle(rasterizer->projectBasicPerspective(test_triangle[0]),
-                                 rasterizer->projectBasicPerspective(test_triangle[1]),
-                                 rasterizer->projectBasicPerspective(test_triangle[2]), *frameBuffer, color3);
+        // Resizing only changes the viewport of the existing buffers, the next frame is redrawn in full
+        if (dynamicResolution->update(raster_ms))
+        {
+            auto render_width = dynamicResolution->getRenderWidth();
+            auto render_height = dynamicResolution->getRenderHeight();
+            frameBuffer->setViewport(render_width, render_height);
+            rasterizer->setViewport(render_width, render_height);
+            dirtyTracker->resize(render_width, render_height);
+        }
 
-        SDL_UpdateTexture(texture, NULL, frameBuffer->getBuffer().data(), width * sizeof(cam3d::ARGB));
         SDL_RenderTexture(renderer, texture, NULL, NULL);
+
+        // Frame time overlay, percentiles over the last few seconds
+        auto stats = scheduler.getStats();
+        std::snprintf(overlay_text, sizeof(overlay_text), "p50 %.1f  p95 %.1f  p99 %.1f ms  work %.2f ms  %s",
+                      stats.p50, stats.p95, stats.p99, stats.work, scheduler.isUncapped() ? "uncapped" : "60 FPS");
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        SDL_RenderDebugText(renderer, 8, 8, overlay_text);
+
         SDL_RenderPresent(renderer);
-        SDL_Delay(16); // ~60 FPS
+        scheduler.endFrame();
     }
 
     SDL_DestroyRenderer(renderer);
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cassert>
+#include <multi_view.hpp>
+
+namespace cam3d
+{
+
+MultiViewRenderer::MultiViewRenderer(std::shared_ptr<ThreadPool> thread_pool) : thread_pool_(std::move(thread_pool))
+{
+    if (!thread_pool_)
+    {
+        thread_pool_ = std::make_shared<ThreadPool>();
+    }
+}
+
+auto MultiViewRenderer::transformToWorld(const Mesh &mesh, const Transform &model_to_world) -> void
+{
+    world_vertices_.resize(mesh.vertices.size());
+    thread_pool_->parallelFor(mesh.vertices.size(), 1024, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            world_vertices_[i] = model_to_world.apply(mesh.vertices[i]);
+        }
+    });
+}
+
+auto MultiViewRenderer::prepareView(size_t view_index, const ViewSetup &view) -> Rasterizer &
+{
+    const auto &intrinsics = view.camera.getIntrinsics();
+    assert(view.target && view.target->getWidth() == intrinsics.width &&
+           view.target->getHeight() == intrinsics.height && "View target must match the camera resolution");
+
+    if (rasterizers_.size() <= view_index)
+    {
+        rasterizers_.resize(view_index + 1);
+        camera_vertices_.resize(view_index + 1);
+        screen_vertices_.resize(view_index + 1);
+    }
+    auto &rasterizer = rasterizers_[view_index];
+    if (!rasterizer || rasterizer->getWidth() != intrinsics.width || rasterizer->getHeight() != intrinsics.height)
+    {
+        rasterizer = std::make_unique<Rasterizer>(intrinsics.width, intrinsics.height);
+    }
+    camera_vertices_[view_index].resize(world_vertices_.size());
+    screen_vertices_[view_index].resize(world_vertices_.size());
+    return *rasterizer;
+}
+
+auto MultiViewRenderer::isOnScreen(const Vector3<float> &p0, const Vector3<float> &p1, const Vector3<float> &p2,
+                                   const CameraIntrinsics &intrinsics) const -> bool
+{
+    return std::max({p0.x(), p1.x(), p2.x()}) >= 0 && std::max({p0.y(), p1.y(), p2.y()}) >= 0 &&
+           std::min({p0.x(), p1.x(), p2.x()}) < static_cast<float>(intrinsics.width) &&
+           std::min({p0.y(), p1.y(), p2.y()}) < static_cast<float>(intrinsics.height);
+}
+
+auto MultiViewRenderer::clipToDepthRange(const Vector3<float> (&triangle)[3], float near_plane, float far_plane,
+                                         Vector3<float> (&clipped)[kMaxClippedVertices]) -> size_t
+{
+    // Clip against one plane at a time, sign is +1 to keep z >= plane and -1 to keep z <= plane
+    auto clip = [](const Vector3<float> *input, size_t count, float plane, float sign, Vector3<float> *output) {
+        size_t written = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto &current = input[i];
+            const auto &next = input[(i + 1) % count];
+            const float d_current = sign * (current.z() - plane);
+            const float d_next = sign * (next.z() - plane);
+            if (d_current >= 0)
+            {
+                output[written++] = current;
+            }
+            if ((d_current >= 0) != (d_next >= 0))
+            {
+                // Snap z onto the plane so the projected depth lands exactly on 0 or 1
+                const float t = d_current / (d_current - d_next);
+                output[written++] = Vector3<float>(current.x() + (next.x() - current.x()) * t,
+                                                   current.y() + (next.y() - current.y()) * t, plane);
+            }
+        }
+        return written;
+    };
+
+    Vector3<float> near_clipped[kMaxClippedVertices];
+    const size_t count = clip(triangle, 3, near_plane, 1.0f, near_clipped);
+    if (count < 3)
+    {
+        return 0;
+    }
+    const size_t corners = clip(near_clipped, count, far_plane, -1.0f, clipped);
+    return corners < 3 ? 0 : corners;
+}
+
+} // namespace cam3d
@@ -0,0 +1,47 @@
+#include <bit>
+#include <cstring>
+#include <pixel_format.hpp>
+
+namespace cam3d
+{
+
+auto convertToARGB8888(const ARGB *src, uint32_t *dst, size_t count) -> void
+{
+    static_assert(sizeof(ARGB) == sizeof(uint32_t), "ARGB must be packed into 32 bits");
+
+    // ARGB is stored as the bytes a, r, g, b. Loaded as a native word that is already ARGB8888 on big endian targets
+    // and needs a byte swap on little endian ones, which compiles to a byte shuffle per vector.
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t value;
+        std::memcpy(&value, static_cast<const void *>(src + i), sizeof(value));
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            value = (value >> 24) | ((value >> 8) & 0x0000ff00u) | ((value << 8) & 0x00ff0000u) | (value << 24);
+        }
+        dst[i] = value;
+    }
+}
+
+auto convertToARGB8888(const RGB565 *src, uint32_t *dst, size_t count) -> void
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t value = src[i].value;
+        const uint32_t r = (value >> 11) & 0x1f;
+        const uint32_t g = (value >> 5) & 0x3f;
+        const uint32_t b = value & 0x1f;
+        // Replicate the top bits into the low bits so full intensity maps to 255
+        dst[i] = 0xff000000u | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+    }
+}
+
+auto convertToARGB8888(const Gray8 *src, uint32_t *dst, size_t count) -> void
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        dst[i] = 0xff000000u | (static_cast<uint32_t>(src[i].value) * 0x00010101u);
+    }
+}
+
+} // namespace cam3d
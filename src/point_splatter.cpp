@@ -0,0 +1,52 @@
+#include <cassert>
+#include <point_splatter.hpp>
+
+namespace cam3d
+{
+
+PointSplatter::PointSplatter(uint32_t width, uint32_t height)
+    : width_(width), height_(height), capacity_(static_cast<size_t>(width) * height),
+      packed_(std::make_unique<std::atomic<uint64_t>[]>(capacity_))
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        packed_[i].store(kEmpty, std::memory_order_relaxed);
+    }
+}
+
+auto PointSplatter::setViewport(uint32_t width, uint32_t height) -> void
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    assert(static_cast<size_t>(width) * height <= capacity_ && "Viewport exceeds the allocated size");
+    width_ = width;
+    height_ = height;
+}
+
+auto PointSplatter::resolve(FrameBuffer &fb, uint32_t y_begin, uint32_t y_end) -> void
+{
+    assert(fb.getWidth() == width_ && fb.getHeight() == height_ && "Frame buffer size does not match the splatter");
+
+    auto &color_buffer = fb.getBuffer();
+    auto &depth_buffer = fb.getDepthBuffer();
+    for (size_t index = static_cast<size_t>(y_begin) * width_; index < static_cast<size_t>(y_end) * width_; ++index)
+    {
+        const uint64_t packed = packed_[index].load(std::memory_order_relaxed);
+        if (packed == kEmpty)
+        {
+            continue;
+        }
+        packed_[index].store(kEmpty, std::memory_order_relaxed);
+
+        const float depth = std::bit_cast<float>(static_cast<uint32_t>(packed >> 32));
+        if (depth < depth_buffer[index])
+        {
+            const auto argb = static_cast<uint32_t>(packed);
+            depth_buffer[index] = depth;
+            color_buffer[index] = ARGB(static_cast<uint8_t>(argb >> 24), static_cast<uint8_t>(argb >> 16),
+                                       static_cast<uint8_t>(argb >> 8), static_cast<uint8_t>(argb));
+        }
+    }
+}
+
+} // namespace cam3d
@@ -1,32 +1,436 @@
 #include "vector3.hpp"
 #include <algorithm>
 #include <iostream>
+#include <numbers>
 #include <rasterizer.hpp>
 namespace cam3d
 {
 
 Rasterizer::Rasterizer(uint32_t width, uint32_t height)
-    : width_(width), height_(height), aspect_ratio_(static_cast<float>(width) / height), fov_(60),
-      focal_length_(1 / std::tan(fov_ / 2)), near_plane_(0.1f), far_plane_(1000.0f)
+    : width_(width), height_(height), aspect_ratio_(static_cast<float>(width) / height), scissor_{0, 0, width, height},
+      depth_test_(DepthTest::Less), dirty_tracker_(nullptr)
 {
     assert(width > 0 && height > 0 && "Width and height must be greater than zero");
 
-    // Initialize the projection matrix
+    setPerspective(60, 0.1f, 1000.0f);
+
+    clipper_ = std::make_unique<CohenSutherland>(width, height);
+    bresenham_ = std::make_unique<Bresenham>();
+    intersectionCalculator_ = std::make_unique<IntersectionCalculator>();
+}
+
+auto Rasterizer::setPerspective(float fov_degrees, float near_plane, float far_plane) -> void
+{
+    assert(fov_degrees > 0 && fov_degrees < 180 && "Field of view must be in (0, 180) degrees");
+    assert(near_plane > 0 && far_plane > near_plane && "Invalid clipping planes");
+
+    fov_ = fov_degrees;
+    focal_length_ = 1 / std::tan(fov_ * std::numbers::pi_v<float> / 360); // tan takes half the fov in radians
+    near_plane_ = near_plane;
+    far_plane_ = far_plane;
+
     projection_matrix_ =
         std::array<std::array<float, 4>, 4>{{{focal_length_ / aspect_ratio_, 0, 0, 0},
                                              {0, focal_length_, 0, 0},
                                              {0, 0, (far_plane_ + near_plane_) / (near_plane_ - far_plane_),
                                               (2 * far_plane_ * near_plane_) / (near_plane_ - far_plane_)},
                                              {0, 0, -1, 0}}};
+}
 
-    clipper_ = std::make_unique<CohenSutherland>(width, height);
-    bresenham_ = std::make_unique<Bresenham>();
-    intersectionCalculator_ = std::make_unique<IntersectionCalculator>();
+auto Rasterizer::getBatchProjection() const -> BatchProjection
+{
+    return BatchProjection{projection_matrix_[0][0],
+                           projection_matrix_[1][1],
+                           projection_matrix_[3][2],
+                           static_cast<float>(width_ - 1) / 2,
+                           static_cast<float>(height_ - 1) / 2,
+                           near_plane_,
+                           far_plane_,
+                           1.0f / (far_plane_ - near_plane_)};
+}
+
+auto Rasterizer::beginFrame() -> void
+{
+    frame_arena_.reset();
+}
+
+auto Rasterizer::getFrameArena() -> FrameArena &
+{
+    return frame_arena_;
+}
+
+auto Rasterizer::setViewport(uint32_t width, uint32_t height) -> void
+{
+    assert(width > 0 && height > 0 && "Width and height must be greater than zero");
+    width_ = width;
+    height_ = height;
+    aspect_ratio_ = static_cast<float>(width) / height;
+    setPerspective(fov_, near_plane_, far_plane_);
+    clipper_->setBounds(width, height);
+    resetScissor();
+}
+
+auto Rasterizer::getWidth() const -> uint32_t
+{
+    return width_;
+}
+
+auto Rasterizer::getHeight() const -> uint32_t
+{
+    return height_;
+}
+
+auto Rasterizer::setScissor(const Rect &rect) -> void
+{
+    assert(rect.x + rect.width <= width_ && rect.y + rect.height <= height_ && "Scissor out of bounds");
+    scissor_ = rect;
+}
+
+auto Rasterizer::resetScissor() -> void
+{
+    scissor_ = Rect{0, 0, width_, height_};
+}
+
+auto Rasterizer::getTriangleBounds(const Vector3<float> &p1, const Vector3<float> &p2,
+                                   const Vector3<float> &p3) const -> Rect
+{
+    const float min_x = std::max(0.0f, std::floor(std::min({p1.x(), p2.x(), p3.x()})));
+    const float max_x = std::min(static_cast<float>(width_ - 1), std::ceil(std::max({p1.x(), p2.x(), p3.x()})));
+    const float min_y = std::max(0.0f, std::floor(std::min({p1.y(), p2.y(), p3.y()})));
+    const float max_y = std::min(static_cast<float>(height_ - 1), std::ceil(std::max({p1.y(), p2.y(), p3.y()})));
+    if (min_x > max_x || min_y > max_y)
+    {
+        return Rect{0, 0, 0, 0};
+    }
+    return Rect{static_cast<uint32_t>(min_x), static_cast<uint32_t>(min_y),
+                static_cast<uint32_t>(max_x - min_x) + 1, static_cast<uint32_t>(max_y - min_y) + 1};
+}
+
+auto Rasterizer::setThreadPool(std::shared_ptr<ThreadPool> thread_pool) -> void
+{
+    thread_pool_ = std::move(thread_pool);
+    if (thread_pool_)
+    {
+        frame_arena_.setThreadCount(thread_pool_->getThreadCount());
+    }
+}
+
+auto Rasterizer::getThreadPool() -> ThreadPool &
+{
+    if (!thread_pool_)
+    {
+        setThreadPool(std::make_shared<ThreadPool>());
+    }
+    return *thread_pool_;
+}
+
+auto Rasterizer::drawPoints(const Vector3<float> *points, const ARGB *colors, size_t count, FrameBuffer &fb,
+                            uint32_t point_size) -> void
+{
+    assert(point_size > 0 && "Point size must be greater than zero");
+    if (count == 0)
+    {
+        return;
+    }
+    if (dirty_tracker_)
+    {
+        // Points are only projected when splatted, so the whole scissor rectangle is recorded as their bounds
+        auto signature = beginSignature(DrawKind::Points).add(count).add(point_size);
+        for (size_t i = 0; i < count; ++i)
+        {
+            signature.add(points[i]).add(colors[i]);
+        }
+        dirty_tracker_->record(scissor_, signature.getValue());
+        return;
+    }
+    auto &thread_pool = getThreadPool();
+    // The splatter only grows, a dynamic resolution step just moves its viewport like the frame buffer's
+    if (!point_splatter_ || point_splatter_->getCapacity() < static_cast<size_t>(fb.getWidth()) * fb.getHeight())
+    {
+        point_splatter_ = std::make_unique<PointSplatter>(fb.getWidth(), fb.getHeight());
+    }
+    else if (point_splatter_->getWidth() != fb.getWidth() || point_splatter_->getHeight() != fb.getHeight())
+    {
+        point_splatter_->setViewport(fb.getWidth(), fb.getHeight());
+    }
+
+    const BatchProjection projection = getBatchProjection();
+
+    const auto half_size = static_cast<int>(point_size / 2);
+    const auto clip_min_x = static_cast<int>(scissor_.x);
+    const auto clip_min_y = static_cast<int>(scissor_.y);
+    const auto clip_max_x = static_cast<int>(scissor_.x + scissor_.width) - 1;
+    const auto clip_max_y = static_cast<int>(scissor_.y + scissor_.height) - 1;
+    const auto reach = static_cast<float>(point_size);
+    auto &splatter = *point_splatter_;
+
+    thread_pool.parallelFor(count, 4096, [&](size_t begin, size_t end, size_t worker) {
+        // The whole chunk is projected in one branch free loop into scratch from this worker's sub arena
+        auto &arena = frame_arena_.local(worker);
+        ArenaScope scope(arena);
+        const size_t chunk = end - begin;
+        ArenaVector<float> sx(chunk, ArenaAllocator<float>(arena));
+        ArenaVector<float> sy(chunk, ArenaAllocator<float>(arena));
+        ArenaVector<float> sz(chunk, ArenaAllocator<float>(arena));
+        ArenaVector<uint8_t> visible(chunk, ArenaAllocator<uint8_t>(arena));
+        for (size_t i = 0; i < chunk; ++i)
+        {
+            const auto &p = points[begin + i];
+            const bool in_depth = projection.project(p.x(), p.y(), p.z(), sx[i], sy[i], sz[i]);
+            visible[i] = in_depth & (sx[i] > clip_min_x - reach) & (sx[i] < clip_max_x + reach) &
+                         (sy[i] > clip_min_y - reach) & (sy[i] < clip_max_y + reach);
+        }
+
+        for (size_t i = 0; i < chunk; ++i)
+        {
+            if (!visible[i])
+            {
+                continue;
+            }
+            const int x0 = static_cast<int>(std::floor(sx[i])) - half_size;
+            const int y0 = static_cast<int>(std::floor(sy[i])) - half_size;
+            const int x_first = std::max(x0, clip_min_x);
+            const int y_first = std::max(y0, clip_min_y);
+            const int x_last = std::min(x0 + static_cast<int>(point_size) - 1, clip_max_x);
+            const int y_last = std::min(y0 + static_cast<int>(point_size) - 1, clip_max_y);
+            const uint32_t argb = colors[begin + i].toUint32();
+            for (int y = y_first; y <= y_last; ++y)
+            {
+                for (int x = x_first; x <= x_last; ++x)
+                {
+                    splatter.splat(static_cast<uint32_t>(x), static_cast<uint32_t>(y), sz[i], argb);
+                }
+            }
+        }
+    });
+
+    thread_pool.parallelFor(fb.getHeight(), 16, [&](size_t begin, size_t end, size_t) {
+        splatter.resolve(fb, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+    });
+}
+
+template <typename Pixel>
+auto Rasterizer::drawInstanced(const Mesh &mesh, const Transform *instance_transforms, const ARGB *instance_colors,
+                               size_t count, BasicFrameBuffer<Pixel> &fb) -> void
+{
+    const size_t vertex_count = mesh.vertices.size();
+    if (count == 0 || vertex_count == 0 || mesh.indices.size() < 3)
+    {
+        return;
+    }
+
+    constexpr size_t kBatch = 8;
+
+    const BatchProjection projection = getBatchProjection();
+
+    // The side planes of the frustum are |x| * x_slope <= z and |y| * y_slope <= z, normalized for sphere distances
+    const float x_slope = std::abs(projection.x_scale / projection.w_scale);
+    const float y_slope = std::abs(projection.y_scale / projection.w_scale);
+    const float x_plane_norm = 1.0f / std::sqrt(x_slope * x_slope + 1);
+    const float y_plane_norm = 1.0f / std::sqrt(y_slope * y_slope + 1);
+    const auto sphere = mesh.getBoundingSphere();
+
+    auto &arena = frame_arena_.local(0);
+    ArenaScope scope(arena);
+
+    // Cull whole instances by their transformed bounding sphere, eight per batch with lanes past the end masked out
+    ArenaVector<uint32_t> visible{ArenaAllocator<uint32_t>(arena)};
+    visible.reserve(count);
+    for (size_t base = 0; base < count; base += kBatch)
+    {
+        const size_t lanes = std::min(kBatch, count - base);
+        bool inside[kBatch];
+        for (size_t lane = 0; lane < kBatch; ++lane)
+        {
+            const auto &m = instance_transforms[base + std::min(lane, lanes - 1)].getMatrix();
+            const auto &c = sphere.center;
+            const float cx = m[0][0] * c.x() + m[0][1] * c.y() + m[0][2] * c.z() + m[0][3];
+            const float cy = m[1][0] * c.x() + m[1][1] * c.y() + m[1][2] * c.z() + m[1][3];
+            const float cz = m[2][0] * c.x() + m[2][1] * c.y() + m[2][2] * c.z() + m[2][3];
+            // The longest transformed basis vector bounds how much the transform can stretch the radius
+            const float scale_squared =
+                std::max({m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0],
+                          m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1],
+                          m[0][2] * m[0][2] + m[1][2] * m[1][2] + m[2][2] * m[2][2]});
+            const float radius = sphere.radius * std::sqrt(scale_squared);
+            inside[lane] = (lane < lanes) & (cz + radius >= projection.near_plane) &
+                           (cz - radius <= projection.far_plane) &
+                           ((x_slope * std::abs(cx) - cz) * x_plane_norm <= radius) &
+                           ((y_slope * std::abs(cy) - cz) * y_plane_norm <= radius);
+        }
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            if (inside[lane])
+            {
+                visible.push_back(static_cast<uint32_t>(base + lane));
+            }
+        }
+    }
+
+    // Screen positions of one batch, laid out vertex major so lane i of every vertex belongs to the same instance
+    const size_t batch_size = vertex_count * kBatch;
+    ArenaVector<float> screen_x(batch_size, ArenaAllocator<float>(arena));
+    ArenaVector<float> screen_y(batch_size, ArenaAllocator<float>(arena));
+    ArenaVector<float> screen_z(batch_size, ArenaAllocator<float>(arena));
+    ArenaVector<uint8_t> in_depth(batch_size, ArenaAllocator<uint8_t>(arena));
+
+    for (size_t base = 0; base < visible.size(); base += kBatch)
+    {
+        const size_t lanes = std::min(kBatch, visible.size() - base);
+
+        // Transpose the batch matrices so each matrix element is a contiguous run of lanes
+        float m[3][4][kBatch];
+        for (size_t lane = 0; lane < kBatch; ++lane)
+        {
+            const auto &matrix = instance_transforms[visible[base + std::min(lane, lanes - 1)]].getMatrix();
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    m[row][col][lane] = matrix[row][col];
+                }
+            }
+        }
+
+        // Every vertex is broadcast against eight instance matrices, one lane per instance
+        for (size_t v = 0; v < vertex_count; ++v)
+        {
+            const auto &p = mesh.vertices[v];
+            const size_t offset = v * kBatch;
+            for (size_t lane = 0; lane < kBatch; ++lane)
+            {
+                const float x = m[0][0][lane] * p.x() + m[0][1][lane] * p.y() + m[0][2][lane] * p.z() + m[0][3][lane];
+                const float y = m[1][0][lane] * p.x() + m[1][1][lane] * p.y() + m[1][2][lane] * p.z() + m[1][3][lane];
+                const float z = m[2][0][lane] * p.x() + m[2][1][lane] * p.y() + m[2][2][lane] * p.z() + m[2][3][lane];
+                in_depth[offset + lane] = projection.project(x, y, z, screen_x[offset + lane],
+                                                             screen_y[offset + lane], screen_z[offset + lane]);
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const FlatFragmentShader shader{instance_colors[visible[base + lane]]};
+            auto vertex = [&](uint32_t index) {
+                const size_t i = index * kBatch + lane;
+                return Vector3<float>(screen_x[i], screen_y[i], screen_z[i]);
+            };
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+            {
+                const uint32_t i0 = mesh.indices[t];
+                const uint32_t i1 = mesh.indices[t + 1];
+                const uint32_t i2 = mesh.indices[t + 2];
+                if (!(in_depth[i0 * kBatch + lane] & in_depth[i1 * kBatch + lane] & in_depth[i2 * kBatch + lane]))
+                {
+                    continue;
+                }
+                drawTriangle(vertex(i0), vertex(i1), vertex(i2), fb, PassThroughVertexShader{}, shader);
+            }
+        }
+    }
+}
+
+auto Rasterizer::setDepthTest(DepthTest depth_test) -> void
+{
+    depth_test_ = depth_test;
+}
+
+auto Rasterizer::getDepthTest() const -> DepthTest
+{
+    return depth_test_;
 }
 
-auto Rasterizer::drawLine(const Vector3<float> &p_start, const Vector3<float> &p_end, FrameBuffer &fb,
+auto Rasterizer::setDirtyRegionTracker(DirtyRegionTracker *tracker) -> void
+{
+    dirty_tracker_ = tracker;
+}
+
+auto Rasterizer::getDirtyRegionTracker() const -> DirtyRegionTracker *
+{
+    return dirty_tracker_;
+}
+
+auto Rasterizer::beginSignature(DrawKind kind) const -> DrawSignature
+{
+    DrawSignature signature;
+    signature.add(kind).add(depth_test_);
+    return signature;
+}
+
+/**
+ * @param pa, pb, pc The screen space triangle vertices
+ * @param setup Reciprocal area, so both windings give positive weights, and the edges owning the pixel centres on
+ * them. Lanes past setup.x_last are masked out.
+ */
+auto Rasterizer::computeQuadCoverage(const Vector3<float> &pa, const Vector3<float> &pb, const Vector3<float> &pc,
+                                     const TriangleSetup &setup, uint32_t x, uint32_t y, QuadCoverage &quad) -> void
+{
+    const float inv_area = setup.inv_area;
+    const bool top_left0 = setup.top_left[0];
+    const bool top_left1 = setup.top_left[1];
+    const bool top_left2 = setup.top_left[2];
+    const float py = static_cast<float>(y) + 0.5f;
+    for (uint32_t lane = 0; lane < kQuadWidth; ++lane)
+    {
+        const float px = static_cast<float>(x + lane) + 0.5f;
+        quad.w0[lane] = ((pc.x() - pb.x()) * (py - pb.y()) - (pc.y() - pb.y()) * (px - pb.x())) * inv_area;
+        quad.w1[lane] = ((pa.x() - pc.x()) * (py - pc.y()) - (pa.y() - pc.y()) * (px - pc.x())) * inv_area;
+        quad.w2[lane] = ((pb.x() - pa.x()) * (py - pa.y()) - (pb.y() - pa.y()) * (px - pa.x())) * inv_area;
+        quad.z[lane] = quad.w0[lane] * pa.z() + quad.w1[lane] * pb.z() + quad.w2[lane] * pc.z();
+        const bool in0 = (quad.w0[lane] > 0.0f) | ((quad.w0[lane] == 0.0f) & top_left0);
+        const bool in1 = (quad.w1[lane] > 0.0f) | ((quad.w1[lane] == 0.0f) & top_left1);
+        const bool in2 = (quad.w2[lane] > 0.0f) | ((quad.w2[lane] == 0.0f) & top_left2);
+        quad.inside[lane] = in0 & in1 & in2 & (x + lane <= setup.x_last);
+    }
+}
+
+template <typename Pixel>
+auto Rasterizer::drawTriangleDepth(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
+                                   BasicFrameBuffer<Pixel> &fb) -> void
+{
+    if (dirty_tracker_)
+    {
+        dirty_tracker_->record(getTriangleBounds(p1, p2, p3),
+                               beginSignature(DrawKind::TriangleDepth).add(p1).add(p2).add(p3).getValue());
+        return;
+    }
+
+    TriangleSetup setup;
+    if (!setupTriangle(p1, p2, p3, setup))
+    {
+        return;
+    }
+
+    auto &depth_buffer = fb.getDepthBuffer();
+    const uint32_t stride = fb.getWidth();
+
+    QuadCoverage quad;
+    for (uint32_t y = setup.y_first; y <= setup.y_last; ++y)
+    {
+        float *row = depth_buffer.data() + static_cast<size_t>(y) * stride;
+        for (uint32_t x = setup.x_first; x <= setup.x_last; x += kQuadWidth)
+        {
+            computeQuadCoverage(p1, p2, p3, setup, x, y, quad);
+            // Branch free depth minimum, lanes past the end of the span are not touched
+            const uint32_t lanes = std::min(kQuadWidth, setup.x_last - x + 1);
+            for (uint32_t lane = 0; lane < lanes; ++lane)
+            {
+                const float stored = row[x + lane];
+                row[x + lane] = quad.inside[lane] && quad.z[lane] < stored ? quad.z[lane] : stored;
+            }
+        }
+    }
+}
+
+template <typename Pixel>
+auto Rasterizer::drawLine(const Vector3<float> &p_start, const Vector3<float> &p_end, BasicFrameBuffer<Pixel> &fb,
                           const ARGB &color) -> void
 {
+    if (dirty_tracker_)
+    {
+        dirty_tracker_->record(getTriangleBounds(p_start, p_end, p_end),
+                               beginSignature(DrawKind::Line).add(p_start).add(p_end).add(color).getValue());
+        return;
+    }
 
     auto start = (p_start);
     auto end = p_end;
@@ -37,17 +441,33 @@ auto Rasterizer::drawLine(const Vector3<float> &p_start, const Vector3<float> &p
         return; // Line is completely outside the clipping rectangle
     }
 
-    // Bresenham's line algorithm
-    auto points = bresenham_->CalculateLine(start.x(), start.y(), end.x(), end.y());
+    // Bresenham's line algorithm, the points only live until the end of this call
+    auto &arena = frame_arena_.local(0);
+    ArenaScope scope(arena);
+    Bresenham::Points points{ArenaAllocator<std::pair<uint32_t, uint32_t>>(arena)};
+    bresenham_->CalculateLine(start.x(), start.y(), end.x(), end.y(), points);
     for (const auto &point : points)
     {
+        if (point.first < scissor_.x || point.first >= scissor_.x + scissor_.width || point.second < scissor_.y ||
+            point.second >= scissor_.y + scissor_.height)
+        {
+            continue;
+        }
         fb.setPixel(point.first, point.second, p_start.z(), color);
     }
 };
 
+template <typename Pixel>
 auto Rasterizer::drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2, const Vector3<float> &p3,
-                              FrameBuffer &fb, const ARGB &color) -> void
+                              BasicFrameBuffer<Pixel> &fb, const ARGB &color) -> void
 {
+    if (dirty_tracker_)
+    {
+        dirty_tracker_->record(getTriangleBounds(p1, p2, p3),
+                               beginSignature(DrawKind::Triangle).add(p1).add(p2).add(p3).add(color).getValue());
+        return;
+    }
+
     // Draw the triangle edges
     drawLine(p1, p2, fb, color);
     drawLine(p2, p3, fb, color);
@@ -55,8 +475,8 @@ auto Rasterizer::drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2
     // Fill the triangle using a simple scanline algorithm
     // This is a basic implementation and can be improved for performance
     // and accuracy
-    auto minY = std::min({p1.y(), p2.y(), p3.y()});
-    auto maxY = std::max({p1.y(), p2.y(), p3.y()});
+    auto minY = std::max(std::min({p1.y(), p2.y(), p3.y()}), static_cast<float>(scissor_.y));
+    auto maxY = std::min(std::max({p1.y(), p2.y(), p3.y()}), static_cast<float>(scissor_.y + scissor_.height) - 1);
     for (int y = static_cast<int>(minY); y <= static_cast<int>(maxY); ++y)
     {
         uint32_t x_min = width_;
@@ -89,9 +509,12 @@ auto Rasterizer::drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2
             x_max = std::max(x_max, static_cast<uint32_t>(p3p1.second.x()));
             z_min = std::min(z_min, static_cast<uint32_t>(p3p1.second.z()));
         }
-        // Draw the horizontal line between the intersection points
+        // Draw the horizontal line between the intersection points, empty spans are rejected before clipping so a
+        // span ending just inside the scissor is still drawn
         if (x_min < x_max)
         {
+            x_min = std::max(x_min, scissor_.x);
+            x_max = std::min(x_max, scissor_.x + scissor_.width - 1);
             for (uint32_t x = x_min; x <= x_max; ++x)
             {
                 fb.setPixel(x, y, z_min, color);
@@ -100,4 +523,21 @@ auto Rasterizer::drawTriangle(const Vector3<float> &p1, const Vector3<float> &p2
     }
 };
 
+// Explicit instantiations for the supported frame buffer pixel formats
+#define CAM3D_INSTANTIATE_DRAW_CALLS(Pixel)                                                                            \
+    template auto Rasterizer::drawLine(const Vector3<float> &, const Vector3<float> &, BasicFrameBuffer<Pixel> &,      \
+                                       const ARGB &) -> void;                                                          \
+    template auto Rasterizer::drawTriangle(const Vector3<float> &, const Vector3<float> &, const Vector3<float> &,     \
+                                           BasicFrameBuffer<Pixel> &, const ARGB &) -> void;                           \
+    template auto Rasterizer::drawTriangleDepth(const Vector3<float> &, const Vector3<float> &,                        \
+                                                const Vector3<float> &, BasicFrameBuffer<Pixel> &) -> void;            \
+    template auto Rasterizer::drawInstanced(const Mesh &, const Transform *, const ARGB *, size_t,                     \
+                                            BasicFrameBuffer<Pixel> &) -> void;
+
+CAM3D_INSTANTIATE_DRAW_CALLS(ARGB)
+CAM3D_INSTANTIATE_DRAW_CALLS(RGB565)
+CAM3D_INSTANTIATE_DRAW_CALLS(Gray8)
+
+#undef CAM3D_INSTANTIATE_DRAW_CALLS
+
 } // namespace cam3d
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <submission_queue.hpp>
+#include <tuple>
+
+namespace cam3d
+{
+
+SubmissionProducer::SubmissionProducer(SubmissionQueue &queue, uint32_t layer, uint32_t index)
+    : queue_(queue), layer_(layer), index_(index), sequence_(0), current_(nullptr)
+{
+}
+
+auto SubmissionProducer::getCommandBuffer() -> CommandBuffer &
+{
+    if (!current_)
+    {
+        current_ = acquireBatch();
+    }
+    return current_->commands;
+}
+
+auto SubmissionProducer::submit() -> void
+{
+    if (!current_ || current_->commands.size() == 0)
+    {
+        return;
+    }
+    current_->layer = layer_;
+    current_->producer = index_;
+    current_->sequence = sequence_++;
+    current_->in_flight.store(true, std::memory_order_relaxed);
+    queue_.push(current_);
+    current_ = nullptr;
+}
+
+auto SubmissionProducer::getLayer() const -> uint32_t
+{
+    return layer_;
+}
+
+auto SubmissionProducer::acquireBatch() -> SubmissionBatch *
+{
+    // Batches are handed back by the renderer, a new one is only needed while every batch is still in flight
+    for (auto &batch : batches_)
+    {
+        if (!batch->in_flight.load(std::memory_order_acquire))
+        {
+            return batch.get();
+        }
+    }
+    batches_.push_back(std::make_unique<SubmissionBatch>());
+    return batches_.back().get();
+}
+
+SubmissionQueue::SubmissionQueue() : head_(nullptr)
+{
+}
+
+auto SubmissionQueue::createProducer(uint32_t layer) -> SubmissionProducer &
+{
+    std::lock_guard<std::mutex> lock(producers_mutex_);
+    auto index = static_cast<uint32_t>(producers_.size());
+    producers_.push_back(std::unique_ptr<SubmissionProducer>(new SubmissionProducer(*this, layer, index)));
+    return *producers_.back();
+}
+
+auto SubmissionQueue::push(SubmissionBatch *batch) -> void
+{
+    // Push only stack with a consumer that always takes the whole list, so nodes are never popped one by one and the
+    // compare and swap cannot suffer from ABA
+    batch->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+auto SubmissionQueue::collect(CommandBuffer &frame) -> size_t
+{
+    pending_.clear();
+    for (auto *batch = head_.exchange(nullptr, std::memory_order_acquire); batch; batch = batch->next)
+    {
+        pending_.push_back(batch);
+    }
+
+    std::sort(pending_.begin(), pending_.end(), [](const SubmissionBatch *a, const SubmissionBatch *b) {
+        return std::make_tuple(a->layer, a->producer, a->sequence) <
+               std::make_tuple(b->layer, b->producer, b->sequence);
+    });
+
+    for (auto *batch : pending_)
+    {
+        frame.append(batch->commands);
+        batch->commands.clear();
+        batch->in_flight.store(false, std::memory_order_release);
+    }
+    return pending_.size();
+}
+
+} // namespace cam3d
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <thread_pool.hpp>
+
+namespace cam3d
+{
+
+ThreadPool::ThreadPool(size_t thread_count)
+    : generation_(0), active_workers_(0), stopping_(false), invoke_(nullptr), context_(nullptr), count_(0),
+      chunk_size_(1), next_chunk_(0)
+{
+    thread_count = std::max<size_t>(thread_count, 1);
+    workers_.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+auto ThreadPool::getThreadCount() const -> size_t
+{
+    return workers_.size() + 1;
+}
+
+auto ThreadPool::dispatch(size_t count, size_t grain, Invoke invoke, void *context) -> void
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // A few chunks per thread balances uneven work without hammering the shared counter
+    size_t chunk_size = std::max<size_t>(grain, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+    if (workers_.empty() || chunk_size >= count)
+    {
+        invoke(context, 0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        invoke_ = invoke;
+        context_ = context;
+        count_ = count;
+        chunk_size_ = chunk_size;
+        next_chunk_.store(0, std::memory_order_relaxed);
+        active_workers_ = workers_.size();
+        ++generation_;
+    }
+    work_ready_.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this] { return active_workers_ == 0; });
+}
+
+auto ThreadPool::work(size_t worker_index) -> void
+{
+    while (true)
+    {
+        size_t begin = next_chunk_.fetch_add(chunk_size_, std::memory_order_relaxed);
+        if (begin >= count_)
+        {
+            return;
+        }
+        invoke_(context_, begin, std::min(begin + chunk_size_, count_), worker_index);
+    }
+}
+
+auto ThreadPool::run(size_t worker_index) -> void
+{
+    uint64_t seen_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_)
+            {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        work(worker_index);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_workers_ == 0)
+        {
+            work_done_.notify_one();
+        }
+    }
+}
+
+} // namespace cam3d
@@ -0,0 +1,177 @@
+/**
+ * @file depth_prepass_test.cpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief Checks that the depth prepass writes exactly the depths of the shaded kernel, so DepthTest::Equal shades
+ * every visible pixel once
+ * @version 0.1
+ * @date 2025-05-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <command_buffer.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <frame_buffer.hpp>
+#include <limits>
+#include <random>
+#include <rasterizer.hpp>
+#include <shader.hpp>
+#include <vector3.hpp>
+#include <vector>
+
+int main()
+{
+    // Odd sizes so spans end inside a quad
+    constexpr uint32_t width = 643;
+    constexpr uint32_t height = 481;
+    constexpr int triangle_count = 50;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> x_dist(-50.0f, width + 50.0f);
+    std::uniform_real_distribution<float> y_dist(-50.0f, height + 50.0f);
+    std::uniform_real_distribution<float> z_dist(0.0f, 1.0f);
+    std::vector<cam3d::Vector3<float>> vertices;
+    for (int i = 0; i < triangle_count * 3; ++i)
+    {
+        vertices.emplace_back(x_dist(gen), y_dist(gen), z_dist(gen));
+    }
+
+    cam3d::Rasterizer rasterizer(width, height);
+    cam3d::FrameBuffer color_pass(width, height);
+    cam3d::FrameBuffer prepass(width, height);
+    color_pass.clear();
+    prepass.clear();
+
+    for (int t = 0; t < triangle_count; ++t)
+    {
+        rasterizer.drawTriangle(vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2], color_pass,
+                                cam3d::PassThroughVertexShader{}, cam3d::DepthFragmentShader{});
+        rasterizer.drawTriangleDepth(vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2], prepass);
+    }
+
+    const auto &expected = color_pass.getDepthBuffer();
+    const auto &actual = prepass.getDepthBuffer();
+    size_t mismatches = 0;
+    size_t covered = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        mismatches += std::memcmp(&expected[i], &actual[i], sizeof(float)) != 0;
+        covered += expected[i] != std::numeric_limits<uint32_t>::max();
+    }
+    if (mismatches != 0)
+    {
+        std::fprintf(stderr, "prepass depth differs from the color pass at %zu pixels\n", mismatches);
+        return EXIT_FAILURE;
+    }
+
+    // The equal pass after the prepass must reach every covered pixel
+    std::vector<uint8_t> shaded(static_cast<size_t>(width) * height, 0);
+    auto mark = [&](const cam3d::Fragment &fragment, const cam3d::NoVarying &) {
+        shaded[static_cast<size_t>(fragment.y) * width + fragment.x] = 1;
+        return cam3d::ARGB(255, 255, 255, 255);
+    };
+    rasterizer.setDepthTest(cam3d::DepthTest::Equal);
+    for (int t = 0; t < triangle_count; ++t)
+    {
+        rasterizer.drawTriangle(vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2], prepass,
+                                cam3d::PassThroughVertexShader{}, mark);
+    }
+    size_t shaded_count = 0;
+    for (auto value : shaded)
+    {
+        shaded_count += value;
+    }
+    if (shaded_count != covered)
+    {
+        std::fprintf(stderr, "equal pass shaded %zu of %zu covered pixels\n", shaded_count, covered);
+        return EXIT_FAILURE;
+    }
+
+    // Triangles sharing an edge, half a pixel off the grid so pixel centres lie exactly on the vertical, horizontal
+    // and diagonal edges. Each pixel centre belongs to one triangle, so the equal pass shades every pixel exactly once.
+    constexpr int cells = 4;
+    constexpr float cell_size = 25.0f;
+    constexpr float origin = 100.5f;
+    auto grid_vertex = [&](int i, int j) {
+        const float x = origin + i * cell_size;
+        const float y = origin + j * cell_size;
+        return cam3d::Vector3<float>(x, y, 0.25f + 0.001f * x + 0.0005f * y);
+    };
+    std::vector<cam3d::Vector3<float>> grid;
+    for (int j = 0; j < cells; ++j)
+    {
+        for (int i = 0; i < cells; ++i)
+        {
+            const auto p00 = grid_vertex(i, j);
+            const auto p10 = grid_vertex(i + 1, j);
+            const auto p01 = grid_vertex(i, j + 1);
+            const auto p11 = grid_vertex(i + 1, j + 1);
+            // Alternate the diagonal and the winding from cell to cell
+            if ((i + j) % 2 == 0)
+            {
+                grid.insert(grid.end(), {p00, p10, p11, p00, p01, p11});
+            }
+            else
+            {
+                grid.insert(grid.end(), {p10, p01, p00, p10, p11, p01});
+            }
+        }
+    }
+    cam3d::FrameBuffer grid_buffer(width, height);
+    grid_buffer.clear();
+    rasterizer.setDepthTest(cam3d::DepthTest::Less);
+    for (size_t v = 0; v < grid.size(); v += 3)
+    {
+        rasterizer.drawTriangleDepth(grid[v], grid[v + 1], grid[v + 2], grid_buffer);
+    }
+    size_t grid_covered = 0;
+    for (auto depth : grid_buffer.getDepthBuffer())
+    {
+        grid_covered += depth != std::numeric_limits<uint32_t>::max();
+    }
+    size_t grid_shaded = 0;
+    auto count = [&](const cam3d::Fragment &, const cam3d::NoVarying &) {
+        ++grid_shaded;
+        return cam3d::ARGB(255, 255, 255, 255);
+    };
+    rasterizer.setDepthTest(cam3d::DepthTest::Equal);
+    for (size_t v = 0; v < grid.size(); v += 3)
+    {
+        rasterizer.drawTriangle(grid[v], grid[v + 1], grid[v + 2], grid_buffer, cam3d::PassThroughVertexShader{},
+                                count);
+    }
+    const auto grid_pixels = static_cast<size_t>(cells * cell_size * cells * cell_size);
+    if (grid_covered != grid_pixels || grid_shaded != grid_pixels)
+    {
+        std::fprintf(stderr, "adjacent triangles covered %zu and shaded %zu of %zu pixels\n", grid_covered,
+                     grid_shaded, grid_pixels);
+        return EXIT_FAILURE;
+    }
+
+    // Draws the prepass skipped must still show up in the color pass that follows it
+    cam3d::CommandBuffer commands;
+    const cam3d::ARGB opaque_color(255, 255, 0, 0);
+    const cam3d::ARGB overlay_color(255, 0, 0, 255);
+    commands.recordTriangle(cam3d::Vector3<float>(0, 0, 0.5f), cam3d::Vector3<float>(200, 0, 0.5f),
+                            cam3d::Vector3<float>(0, 200, 0.5f), opaque_color);
+    commands.recordTriangle(cam3d::Vector3<float>(0, 0, 0.2f), cam3d::Vector3<float>(100, 0, 0.2f),
+                            cam3d::Vector3<float>(0, 100, 0.2f), overlay_color, cam3d::FillMode::Flat, false);
+    cam3d::FrameBuffer replay(width, height);
+    replay.clear();
+    rasterizer.setDepthTest(cam3d::DepthTest::Less);
+    commands.executeDepthOnly(rasterizer, replay);
+    commands.executeAfterPrepass(rasterizer, replay);
+    if (replay.getPixel(10, 10).toUint32() != overlay_color.toUint32() ||
+        replay.getPixel(150, 20).toUint32() != opaque_color.toUint32() ||
+        rasterizer.getDepthTest() != cam3d::DepthTest::Less)
+    {
+        std::fprintf(stderr, "replay after the prepass lost a draw or did not restore the depth test\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("depth prepass matches the color pass at %zu covered pixels\n", covered);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file frame_arena_test.cpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief Checks that steady state frames do not touch the global heap once the frame arena has warmed up, including
+ * the per worker scratch of the threaded point splatting and dynamic resolution steps
+ * @version 0.1
+ * @date 2025-05-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <frame_buffer.hpp>
+#include <mesh.hpp>
+#include <memory>
+#include <new>
+#include <rasterizer.hpp>
+#include <thread_pool.hpp>
+#include <transform.hpp>
+#include <vector3.hpp>
+#include <vector>
+
+namespace
+{
+
+std::atomic<size_t> heap_allocations{0};
+
+} // namespace
+
+auto operator new(std::size_t size) -> void *
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+auto operator delete(void *ptr) noexcept -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void *ptr, std::size_t) noexcept -> void
+{
+    std::free(ptr);
+}
+
+int main()
+{
+    constexpr uint32_t width = 320;
+    constexpr uint32_t height = 240;
+    constexpr int warm_up_frames = 3;
+    constexpr int measured_frames = 10;
+
+    cam3d::Rasterizer rasterizer(width, height);
+    cam3d::FrameBuffer frame_buffer(width, height);
+
+    cam3d::Mesh cube;
+    for (int i = 0; i < 8; ++i)
+    {
+        cube.vertices.emplace_back((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+    }
+    cube.indices = {0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+                    2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+    std::vector<cam3d::Transform> transforms;
+    std::vector<cam3d::ARGB> colors;
+    for (int i = 0; i < 100; ++i)
+    {
+        transforms.push_back(cam3d::Transform::translation(
+            cam3d::Vector3<float>(static_cast<float>(i % 10) - 5, static_cast<float>(i / 10) - 5, 20)));
+        colors.emplace_back(255, static_cast<uint8_t>(i * 2), 128, 64);
+    }
+
+    // Enough points for several chunks per worker, so every sub arena is used
+    rasterizer.setThreadPool(std::make_shared<cam3d::ThreadPool>(4));
+    std::vector<cam3d::Vector3<float>> points;
+    std::vector<cam3d::ARGB> point_colors;
+    for (int i = 0; i < 50000; ++i)
+    {
+        points.emplace_back(static_cast<float>(i % 200) * 0.05f - 5, static_cast<float>(i / 200) * 0.04f - 5, 15);
+        point_colors.emplace_back(255, 255, static_cast<uint8_t>(i), 0);
+    }
+
+    size_t steady_allocations = 0;
+    for (int frame = 0; frame < warm_up_frames + measured_frames; ++frame)
+    {
+        const size_t before = heap_allocations.load(std::memory_order_relaxed);
+
+        // Alternate the render resolution like DynamicResolution does, resizing must reuse every buffer
+        const uint32_t render_width = frame % 2 == 0 ? width : width * 3 / 4;
+        const uint32_t render_height = frame % 2 == 0 ? height : height * 3 / 4;
+        frame_buffer.setViewport(render_width, render_height);
+        rasterizer.setViewport(render_width, render_height);
+
+        rasterizer.beginFrame();
+        frame_buffer.clear();
+        for (int i = 0; i < 16; ++i)
+        {
+            const auto offset = static_cast<float>(i * 10 + frame);
+            rasterizer.drawLine(cam3d::Vector3<float>(offset, 0, 0),
+                                cam3d::Vector3<float>(width - 1 - offset, height - 1, 0), frame_buffer,
+                                cam3d::ARGB(255, 255, 255, 255));
+        }
+        rasterizer.drawInstanced(cube, transforms.data(), colors.data(), transforms.size(), frame_buffer);
+        rasterizer.drawPoints(points.data(), point_colors.data(), points.size(), frame_buffer, 2);
+
+        if (frame >= warm_up_frames)
+        {
+            steady_allocations += heap_allocations.load(std::memory_order_relaxed) - before;
+        }
+    }
+
+    if (rasterizer.getFrameArena().getThreadCount() != 4)
+    {
+        std::fprintf(stderr, "frame arena has %zu sub arenas for 4 pool threads\n",
+                     rasterizer.getFrameArena().getThreadCount());
+        return EXIT_FAILURE;
+    }
+    if (steady_allocations != 0)
+    {
+        std::fprintf(stderr, "%zu heap allocations in %d steady state frames\n", steady_allocations, measured_frames);
+        return EXIT_FAILURE;
+    }
+    std::printf("no heap allocations in %d steady state frames\n", measured_frames);
+    return EXIT_SUCCESS;
+}
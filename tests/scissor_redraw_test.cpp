@@ -0,0 +1,89 @@
+/**
+ * @file scissor_redraw_test.cpp
+ * @author Bilal Kahraman (kahramannbilal@gmail.com)
+ * @brief Checks that redrawing a frame tile by tile under a scissor, as dirty regions are, matches drawing it once
+ * @version 0.1
+ * @date 2025-05-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <frame_buffer.hpp>
+#include <random>
+#include <rasterizer.hpp>
+#include <vector3.hpp>
+#include <vector>
+
+int main()
+{
+    constexpr uint32_t width = 320;
+    constexpr uint32_t height = 240;
+    constexpr uint32_t tile_size = 32;
+
+    cam3d::Rasterizer rasterizer(width, height);
+    cam3d::FrameBuffer full(width, height);
+    cam3d::FrameBuffer tiled(width, height);
+
+    // Triangles reach past the screen edges so spans are clipped by both the screen and the tiles
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> x_dist(-20.0f, width + 20.0f);
+    std::uniform_real_distribution<float> y_dist(-20.0f, height + 20.0f);
+    std::uniform_real_distribution<float> z_dist(0.1f, 0.9f);
+    std::vector<std::array<cam3d::Vector3<float>, 3>> triangles;
+    std::vector<cam3d::ARGB> colors;
+    for (int i = 0; i < 50; ++i)
+    {
+        std::array<cam3d::Vector3<float>, 3> triangle;
+        for (auto &vertex : triangle)
+        {
+            vertex = cam3d::Vector3<float>(x_dist(rng), y_dist(rng), z_dist(rng));
+        }
+        triangles.push_back(triangle);
+        colors.emplace_back(255, static_cast<uint8_t>(i * 5), static_cast<uint8_t>(i * 3), 128);
+    }
+
+    const cam3d::ARGB background(255, 16, 16, 16);
+    auto draw_scene = [&](cam3d::FrameBuffer &frame_buffer) {
+        for (size_t i = 0; i < triangles.size(); ++i)
+        {
+            rasterizer.drawTriangle(triangles[i][0], triangles[i][1], triangles[i][2], frame_buffer, colors[i]);
+        }
+    };
+
+    full.clear(background);
+    draw_scene(full);
+
+    for (uint32_t y = 0; y < height; y += tile_size)
+    {
+        for (uint32_t x = 0; x < width; x += tile_size)
+        {
+            const cam3d::Rect tile{x, y, std::min(tile_size, width - x), std::min(tile_size, height - y)};
+            rasterizer.setScissor(tile);
+            tiled.clear(tile, background);
+            draw_scene(tiled);
+        }
+    }
+    rasterizer.resetScissor();
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+    {
+        if (std::memcmp(&full.getBuffer()[i], &tiled.getBuffer()[i], sizeof(cam3d::ARGB)) != 0)
+        {
+            ++mismatches;
+        }
+    }
+    if (mismatches != 0)
+    {
+        std::fprintf(stderr, "%zu pixels differ between the full and the tiled redraw\n", mismatches);
+        return EXIT_FAILURE;
+    }
+    std::printf("tiled redraw matches the full frame\n");
+    return EXIT_SUCCESS;
+}